@@ -0,0 +1,51 @@
+// ParseDouble против strtod на типичных координатах OBJ.
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "model/fast_number.h"
+
+namespace {
+
+const std::vector<std::string> &Corpus() {
+  static const std::vector<std::string> corpus = [] {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+    std::vector<std::string> v;
+    for (int i = 0; i < 4096; ++i) v.push_back(std::to_string(dist(rng)));
+    return v;
+  }();
+  return corpus;
+}
+
+void BM_Strtod(benchmark::State &state) {
+  const auto &corpus = Corpus();
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (const auto &s : corpus) sum += std::strtod(s.c_str(), nullptr);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+
+void BM_ParseDouble(benchmark::State &state) {
+  const auto &corpus = Corpus();
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (const auto &s : corpus) {
+      double v = 0.0;
+      s21::ParseDouble(s.data(), s.data() + s.size(), v);
+      sum += v;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+
+BENCHMARK(BM_Strtod);
+BENCHMARK(BM_ParseDouble);
+
+}  // namespace
@@ -0,0 +1,58 @@
+// Масштабирование ObjParser::Load по числу потоков.
+// Запуск: ./3DViewer_bench --benchmark_filter=ObjParser
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <string>
+
+#include "core/parallel.h"
+#include "model/obj_model.h"
+#include "model/obj_parser.h"
+
+namespace {
+
+// Сетка N x N вершин с четырёхугольными гранями (~60 МБ при N = 1000)
+const std::string &GridObjPath() {
+  static const std::string path = [] {
+    const std::string name = "bench_grid.obj";
+    std::ofstream f(name, std::ios::binary | std::ios::trunc);
+    const int n = 1000;
+    for (int y = 0; y < n; ++y)
+      for (int x = 0; x < n; ++x)
+        f << "v " << x * 0.001 << ' ' << y * 0.001 << ' ' << (x ^ y) * 1e-4
+          << '\n';
+    for (int y = 0; y + 1 < n; ++y)
+      for (int x = 0; x + 1 < n; ++x) {
+        const int i = y * n + x + 1;
+        f << "f " << i << ' ' << i + 1 << ' ' << i + n + 1 << ' ' << i + n
+          << '\n';
+      }
+    return name;
+  }();
+  return path;
+}
+
+void BM_ObjParserLoad(benchmark::State &state) {
+  const std::string &path = GridObjPath();
+  s21::ObjParser parser;
+  parser.SetThreadCount(static_cast<unsigned>(state.range(0)));
+  for (auto _ : state) {
+    s21::Model m;
+    parser.Load(path, m);
+    benchmark::DoNotOptimize(m.GetNumVertices());
+  }
+  state.SetLabel(std::to_string(state.range(0)) + " threads");
+}
+
+void ThreadArgs(benchmark::internal::Benchmark *b) {
+  const unsigned hw = s21::HardwareThreads();
+  for (unsigned t = 1; t < hw; t *= 2) b->Arg(t);
+  b->Arg(hw);
+}
+
+BENCHMARK(BM_ObjParserLoad)
+    ->Apply(ThreadArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
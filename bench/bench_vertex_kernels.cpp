@@ -0,0 +1,108 @@
+// Векторные ядра AABB/преобразований против прежнего скалярного AoS-кода.
+// Запуск: ./3DViewer_bench --benchmark_filter=Vertex
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "model/obj_model.h"
+#include "model/vertex_kernels.h"
+
+namespace {
+
+constexpr size_t kVertices = size_t(1) << 22;  // ~100 МБ
+
+const std::vector<s21::Model::Vertex> &Cloud() {
+  static const std::vector<s21::Model::Vertex> vs = [] {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> d(-1.0, 1.0);
+    std::vector<s21::Model::Vertex> out;
+    out.reserve(kVertices);
+    for (size_t i = 0; i < kVertices; ++i)
+      out.emplace_back(d(rng), d(rng), d(rng));
+    return out;
+  }();
+  return vs;
+}
+
+// Прежний Model::ComputeAabb: ветвления на каждую компоненту
+s21::Model::Aabb LegacyAabb(const std::vector<s21::Model::Vertex> &vs) {
+  s21::Model::Aabb box{};
+  box.min = box.max = vs.front();
+  for (const auto &v : vs) {
+    if (v.x < box.min.x) box.min.x = v.x;
+    if (v.y < box.min.y) box.min.y = v.y;
+    if (v.z < box.min.z) box.min.z = v.z;
+    if (v.x > box.max.x) box.max.x = v.x;
+    if (v.y > box.max.y) box.max.y = v.y;
+    if (v.z > box.max.z) box.max.z = v.z;
+  }
+  return box;
+}
+
+// Прежний Model::RotateZ: проход за центром AABB и проход поворота
+void LegacyRotateZ(std::vector<s21::Model::Vertex> &vs, double deg) {
+  const auto c = LegacyAabb(vs).center();
+  const double s = std::sin(deg * M_PI / 180.0);
+  const double cs = std::cos(deg * M_PI / 180.0);
+  for (auto &v : vs) {
+    const double x = v.x - c.x, y = v.y - c.y;
+    v.x = x * cs - y * s + c.x;
+    v.y = x * s + y * cs + c.y;
+  }
+}
+
+s21::Model::Affine RotationZ(double deg) {
+  s21::Model::Affine m;
+  const double s = std::sin(deg * M_PI / 180.0);
+  const double cs = std::cos(deg * M_PI / 180.0);
+  m.a[0] = cs;
+  m.a[1] = -s;
+  m.a[3] = s;
+  m.a[4] = cs;
+  return m;
+}
+
+void BM_VertexAabbLegacy(benchmark::State &state) {
+  const auto &vs = Cloud();
+  for (auto _ : state) benchmark::DoNotOptimize(LegacyAabb(vs));
+  state.SetBytesProcessed(int64_t(state.iterations()) * kVertices *
+                          sizeof(s21::Model::Vertex));
+}
+BENCHMARK(BM_VertexAabbLegacy)->Unit(benchmark::kMillisecond);
+
+// Аргумент — SimdLevel: 0 scalar, 1 SSE2, 2 AVX2
+void BM_VertexAabb(benchmark::State &state) {
+  const auto &vs = Cloud();
+  s21::SetSimdLevel(static_cast<s21::SimdLevel>(state.range(0)));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(s21::ComputeBounds(vs.data(), vs.size()));
+  state.SetBytesProcessed(int64_t(state.iterations()) * kVertices *
+                          sizeof(s21::Model::Vertex));
+  s21::SetSimdLevel(s21::DetectSimdLevel());
+}
+BENCHMARK(BM_VertexAabb)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+void BM_VertexRotateLegacy(benchmark::State &state) {
+  auto vs = Cloud();
+  for (auto _ : state) {
+    LegacyRotateZ(vs, 1.0);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_VertexRotateLegacy)->Unit(benchmark::kMillisecond);
+
+void BM_VertexTransform(benchmark::State &state) {
+  auto vs = Cloud();
+  const auto m = RotationZ(1.0);
+  s21::SetSimdLevel(static_cast<s21::SimdLevel>(state.range(0)));
+  for (auto _ : state) {
+    s21::TransformVertices(vs.data(), vs.size(), m);
+    benchmark::ClobberMemory();
+  }
+  s21::SetSimdLevel(s21::DetectSimdLevel());
+}
+BENCHMARK(BM_VertexTransform)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -1,18 +1,54 @@
 #include "controller/controller.h"
 
-#include <QFutureWatcher>
-#include <QtConcurrent/QtConcurrent>
+#include <QDir>
+#include <QMetaObject>
+#include <QStandardPaths>
 #include <chrono>
 
+#include "core/job_scheduler.h"
+
 namespace s21
 {
 
-  Controller::Controller(QObject *parent) : QObject(parent) {}
+  namespace
+  {
+
+    // Каталог бинарного кэша моделей (файлы-спутники *.s21mesh)
+    std::string MeshCacheDir()
+    {
+      const QString base =
+          QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+      if (base.isEmpty())
+      {
+        return {};
+      }
+      return QDir(base).filePath("meshes").toStdString();
+    }
+
+  } // namespace
+
+  Controller::Controller(QObject *parent)
+      : QObject(parent), cache_dir_(MeshCacheDir()) {}
+
+  Controller::~Controller()
+  {
+    // Фоновая загрузка прерывается, а не дорабатывает до конца
+    CancelLoad();
+  }
 
   bool Controller::LoadFromFile(const QString &path, QString *error)
   {
+    CancelLoad();
+    const ModelCache::Key key = ModelCache::MakeKey(path.toStdString());
     std::string err;
-    if (!loader_.Load(path.toStdString(), model_, &err))
+    ModelPtr model = models_.Find(key);
+    if (!model)
+    {
+      CachedObjLoader loader(cache_dir_);
+      model = LoadSnapshot(loader, path.toStdString(), &err);
+      models_.Insert(key, model);
+    }
+    if (!model)
     {
       if (error)
       {
@@ -21,97 +57,191 @@ namespace s21
       }
       return false;
     }
-
-    std::vector<uint32_t> edges;
-    model_.BuildEdges(edges);
+    model_ = std::move(model);
+    transform_.Reset(model_->ComputeAabb());
+    emit TransformChanged(&transform_);
     return true;
   }
 
-  void Controller::LoadAsync(const QString &path)
+  void Controller::CancelLoad()
   {
-    using ResultT =
-        std::tuple<Model, std::vector<uint32_t>, double, std::string>;
-
-    auto future =
-        QtConcurrent::run([pathStr = path.toStdString(), this]() -> ResultT
-                          {
-        auto t0 = std::chrono::steady_clock::now();
-
-        Model m;
-        std::string err;
-        if (!loader_.Load(pathStr, m, &err)) {
-          return {Model{}, std::vector<uint32_t>{}, 0.0,
-                  err.empty() ? "Не удалось загрузить файл" : err};
-        }
-
-        std::vector<uint32_t> edges;
-        m.BuildEdges(edges);
-
-        auto t1 = std::chrono::steady_clock::now();
-        double ms =
-            std::chrono::duration<double, std::milli>(t1 - t0).count();
+    if (load_)
+    {
+      load_->Cancel();
+      load_.reset();
+    }
+    ++load_seq_;
+  }
 
-        return {std::move(m), std::move(edges), ms, std::string{}}; });
+  void Controller::Commit(ModelPtr model, double total_ms)
+  {
+    model_ = std::move(model);
+    transform_.Reset(model_->ComputeAabb());
+    emit Loaded(model_, total_ms);
+    emit TransformChanged(&transform_);
+  }
 
-    auto *watcher = new QFutureWatcher<ResultT>(this);
+  void Controller::SetModelCacheBudget(size_t bytes)
+  {
+    models_.SetBudget(bytes);
+  }
 
-    connect(watcher, &QFutureWatcher<ResultT>::finished, this,
-            [this, watcher]()
-            {
-              auto [m, edges, ms, err] = watcher->future().result();
-              watcher->deleteLater();
+  void Controller::LoadAsync(const QString &path)
+  {
+    CancelLoad();
+    const uint64_t seq = load_seq_;
+
+    // Ключ снимается до загрузки: если файл изменится во время разбора,
+    // следующее открытие не примет устаревшую модель за актуальную
+    const auto lookup = std::chrono::steady_clock::now();
+    const ModelCache::Key key = ModelCache::MakeKey(path.toStdString());
+    if (ModelPtr cached = models_.Find(key))
+    {
+      const auto done = std::chrono::steady_clock::now();
+      Commit(std::move(cached),
+             std::chrono::duration<double, std::milli>(done - lookup).count());
+      return;
+    }
 
-              if (!err.empty())
+    // Прогресс (не чаще раза на процент) и готовые части модели приходят
+    // из рабочих потоков и доставляются в поток UI отложенным вызовом
+    load_ = std::make_shared<LoadControl>(
+        [this, seq](uint64_t bytes, uint64_t total)
+        {
+          QMetaObject::invokeMethod(
+              this,
+              [this, seq, bytes, total]()
               {
-                emit Failed(QString::fromStdString(err));
-                return;
-              }
-
-              model_ = std::move(m);
-              emit Loaded(&model_, std::move(edges), ms);
-            });
-
-    watcher->setFuture(future);
+                if (seq == load_seq_)
+                {
+                  emit Progress(bytes, total);
+                }
+              },
+              Qt::QueuedConnection);
+        });
+    load_->SetChunkSink(
+        [this, seq](LoadedChunkPtr chunk)
+        {
+          QMetaObject::invokeMethod(
+              this,
+              [this, seq, chunk = std::move(chunk)]()
+              {
+                if (seq == load_seq_)
+                {
+                  emit ChunkLoaded(seq, chunk);
+                }
+              },
+              Qt::QueuedConnection);
+        });
+
+    // Загрузка — задача общего пула с приоритетом загрузки: разбор и
+    // рёбра внутри неё делят те же потоки. Результат (только указатель)
+    // возвращается в поток UI отложенным вызовом. У каждой загрузки свой
+    // загрузчик: одновременные загрузки не делят состояние.
+    JobScheduler::Global().Submit(
+        [pathStr = path.toStdString(), control = load_, seq, key, this]()
+        {
+          auto t0 = std::chrono::steady_clock::now();
+
+          std::string err;
+          CachedObjLoader loader(cache_dir_);
+          loader.SetLoadControl(control.get());
+          // Точный AABB (опорная точка вращения) считается здесь же,
+          // а не в потоке UI
+          ModelPtr m = LoadSnapshot(loader, pathStr, &err);
+          if (control->IsCancelled())
+          {
+            // Заменена более новой загрузкой: память отпускаем сразу,
+            // в поток UI ничего не отправляем
+            return;
+          }
+          if (!m && err.empty())
+          {
+            err = "Не удалось загрузить файл";
+          }
+
+          auto t1 = std::chrono::steady_clock::now();
+          double ms =
+              std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+          QMetaObject::invokeMethod(
+              this,
+              [this, seq, key, m = std::move(m), ms, err = std::move(err)]()
+              {
+                if (seq != load_seq_)
+                {
+                  return;
+                }
+                load_.reset();
+                if (!m)
+                {
+                  emit Failed(QString::fromStdString(err));
+                  return;
+                }
+
+                models_.Insert(key, m);
+                Commit(m, ms);
+              },
+              Qt::QueuedConnection);
+        },
+        JobPriority::kLoad, &jobs_);
   }
 
   void Controller::ApplyTranslate(double dx, double dy, double dz)
   {
-    model_.Translate(dx, dy, dz);
-    std::vector<uint32_t> edges;
-    model_.BuildEdges(edges);
-    emit Updated(&model_, std::move(edges));
+    transform_.Translate(dx, dy, dz);
+    emit TransformChanged(&transform_);
   }
 
   void Controller::ApplyScale(double k)
   {
-    model_.Scale(k);
-    std::vector<uint32_t> edges;
-    model_.BuildEdges(edges);
-    emit Updated(&model_, std::move(edges));
+    transform_.Scale(k);
+    emit TransformChanged(&transform_);
   }
 
   void Controller::ApplyRotateX(double deg)
   {
-    model_.RotateX(deg);
-    std::vector<uint32_t> edges;
-    model_.BuildEdges(edges);
-    emit Updated(&model_, std::move(edges));
+    transform_.Rotate(0, deg);
+    emit TransformChanged(&transform_);
   }
 
   void Controller::ApplyRotateY(double deg)
   {
-    model_.RotateY(deg);
-    std::vector<uint32_t> edges;
-    model_.BuildEdges(edges);
-    emit Updated(&model_, std::move(edges));
+    transform_.Rotate(1, deg);
+    emit TransformChanged(&transform_);
   }
 
   void Controller::ApplyRotateZ(double deg)
   {
-    model_.RotateZ(deg);
-    std::vector<uint32_t> edges;
-    model_.BuildEdges(edges);
-    emit Updated(&model_, std::move(edges));
+    transform_.Rotate(2, deg);
+    emit TransformChanged(&transform_);
+  }
+
+  void Controller::ResetTransform()
+  {
+    if (!model_)
+    {
+      return;
+    }
+    transform_.Reset(model_->ComputeAabb());
+    emit TransformChanged(&transform_);
+  }
+
+  void Controller::BakeTransform()
+  {
+    if (!model_ || transform_.IsIdentity())
+    {
+      return;
+    }
+    // Снимки неизменяемы: запекание — в новую копию, старую дочитывают
+    // её держатели (виджет) до получения новой
+    auto baked = std::make_shared<Model>(*model_);
+    baked->Transform(transform_.affine());
+    baked->Bake();
+    model_ = std::move(baked);
+    transform_.MarkBaked();
+    emit Updated(model_);
+    emit TransformChanged(&transform_);
   }
 
 } // namespace s21
@@ -4,10 +4,16 @@
 #include <QObject>
 #include <QString>
 #include <cstdint>
-#include <vector>
+#include <memory>
+#include <string>
 
+#include "core/job_scheduler.h"
+#include "model/load_control.h"
+#include "model/mesh_cache.h"
+#include "model/model_cache.h"
 #include "model/obj_model.h"
 #include "model/obj_parser.h"
+#include "model/transform_state.h"
 
 namespace s21
 {
@@ -18,29 +24,60 @@ namespace s21
 
   public:
     explicit Controller(QObject *parent = nullptr);
+    ~Controller() override;
 
     bool LoadFromFile(const QString &path, QString *error = nullptr);
+    // Новая загрузка отменяет незавершённую предыдущую; модель заменяет
+    // только последняя запрошенная
     void LoadAsync(const QString &path);
+    void CancelLoad();
+    // Бюджет кэша недавно открытых моделей в памяти
+    void SetModelCacheBudget(size_t bytes);
+    const ModelCache &model_cache() const { return models_; }
 
     void ApplyTranslate(double dx, double dy, double dz);
     void ApplyScale(double k);
     void ApplyRotateX(double deg);
     void ApplyRotateY(double deg);
     void ApplyRotateZ(double deg);
+    void ResetTransform();
+    // Переносит текущее преобразование в вершины модели (для экспорта);
+    // интерактивные действия вершин не трогают
+    void BakeTransform();
 
-    const Model *model() const { return &model_; }
+    // Текущий снимок модели (nullptr до первой загрузки)
+    ModelPtr model() const { return model_; }
+    const TransformState &transform() const { return transform_; }
 
   signals:
-    void Loaded(const Model *model,
-                std::vector<uint32_t> edges,
-                double total_ms);
+    // Снимки передаются по указателю: вершины и рёбра не копируются
+    void Loaded(s21::ModelPtr model, double total_ms);
     void Failed(const QString &error);
-    void Updated(const Model *model,
-                 std::vector<uint32_t> edges);
+    // Разобрано bytes из total байт файла текущей загрузки
+    void Progress(quint64 bytes, quint64 total);
+    // Готовая часть модели текущей загрузки load (для показа по ходу
+    // загрузки); модель целиком придёт в Loaded
+    void ChunkLoaded(quint64 load, s21::LoadedChunkPtr chunk);
+    // Изменилась геометрия модели; что перезаливать — по её версиям
+    void Updated(s21::ModelPtr model);
+    // Изменилось интерактивное преобразование (модельная матрица MVP)
+    void TransformChanged(const TransformState *state);
 
   private:
-    Model model_;
-    ObjParser loader_;
+    // Делает модель текущей и сообщает о загрузке
+    void Commit(ModelPtr model, double total_ms);
+
+    ModelPtr model_;
+    TransformState transform_;
+    std::string cache_dir_;
+    ModelCache models_;
+    // Текущая фоновая загрузка и её номер: результаты и прогресс более
+    // ранних (отменённых) загрузок отбрасываются
+    std::shared_ptr<LoadControl> load_;
+    uint64_t load_seq_ = 0;
+    // Фоновые задачи контроллера; разрушается первой и дожидается их,
+    // пока остальные поля ещё живы
+    TaskGroup jobs_;
   };
 
 } // namespace s21
@@ -0,0 +1,203 @@
+#include "core/job_scheduler.h"
+
+#include <chrono>
+
+#include "core/parallel.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr size_t kNotWorker = ~size_t(0);
+
+// Пул и номер очереди текущего потока-исполнителя
+thread_local JobScheduler *t_scheduler = nullptr;
+thread_local size_t t_queue = kNotWorker;
+thread_local JobPriority t_priority = JobPriority::kInteractive;
+
+}  // namespace
+
+void TaskGroup::Finish() {
+  // Под мьютексом: Wait() не вернётся (и группа не разрушится), пока
+  // последняя задача не отпустит его
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    done_.notify_all();
+}
+
+void TaskGroup::Wait() {
+  for (;;) {
+    if (Done()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return;
+    }
+    // Исполнитель пула не простаивает: помогает разобрать очереди
+    if (t_scheduler && t_scheduler->TryRunOne()) continue;
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (t_scheduler)
+      done_.wait_for(lock, std::chrono::milliseconds(1),
+                     [this] { return Done(); });
+    else
+      done_.wait(lock, [this] { return Done(); });
+  }
+}
+
+JobScheduler::JobScheduler(unsigned workers) {
+  // Вызывающий поток сам участвует в ParallelFor: пулу хватает ядер - 1
+  const unsigned n =
+      workers != 0 ? workers : std::max(1u, HardwareThreads() - 1);
+  queues_.reserve(n + 1);
+  for (unsigned i = 0; i <= n; ++i)
+    queues_.push_back(std::make_unique<Queue>());
+  workers_.reserve(n);
+  for (unsigned i = 0; i < n; ++i)
+    workers_.emplace_back([this, i] { WorkerMain(i + 1); });
+}
+
+JobScheduler::~JobScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &w : workers_) w.join();
+}
+
+JobScheduler &JobScheduler::Global() {
+  static JobScheduler scheduler;
+  return scheduler;
+}
+
+JobPriority JobScheduler::CurrentPriority() { return t_priority; }
+
+void JobScheduler::Submit(std::function<void()> fn, JobPriority priority,
+                          TaskGroup *group) {
+  if (group) group->Add();
+  {
+    // Счётчик растёт раньше, чем задача видна: исполнитель, проснувшийся
+    // по нему, в худшем случае повторит поиск
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    queued_.fetch_add(1, std::memory_order_relaxed);
+  }
+  // Из задачи пула — в свою очередь, иначе — в общую
+  Queue &q = *queues_[t_scheduler == this ? t_queue : 0];
+  {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.tasks[static_cast<int>(priority)].push_back(
+        Task{std::move(fn), group, priority});
+  }
+  wake_.notify_one();
+}
+
+bool JobScheduler::PopTask(size_t self, Task &out) {
+  const size_t n = queues_.size();
+  for (int p = 0; p < kPriorities; ++p) {
+    // Своя очередь — с конца, общая и чужие — с начала
+    if (self != kNotWorker) {
+      Queue &q = *queues_[self];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (!q.tasks[p].empty()) {
+        out = std::move(q.tasks[p].back());
+        q.tasks[p].pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    const size_t start = self == kNotWorker ? 0 : self;
+    for (size_t k = 0; k < n; ++k) {
+      const size_t v = (start + k) % n;
+      if (v == self) continue;
+      Queue &q = *queues_[v];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (!q.tasks[p].empty()) {
+        out = std::move(q.tasks[p].front());
+        q.tasks[p].pop_front();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void JobScheduler::Run(Task &task) {
+  if (!task.group || !task.group->IsCancelled()) {
+    const JobPriority outer = t_priority;
+    t_priority = task.priority;
+    task.fn();
+    t_priority = outer;
+  }
+  // Задача освобождается до Finish: группа может быть уже разрушена
+  TaskGroup *group = task.group;
+  task = Task{};
+  if (group) group->Finish();
+}
+
+bool JobScheduler::TryRunOne() {
+  Task task;
+  if (!PopTask(t_scheduler == this ? t_queue : kNotWorker, task)) return false;
+  Run(task);
+  return true;
+}
+
+void JobScheduler::WorkerMain(size_t index) {
+  t_scheduler = this;
+  t_queue = index;
+  for (;;) {
+    Task task;
+    if (PopTask(index, task)) {
+      Run(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_.wait(lock, [this] {
+      return stop_ || queued_.load(std::memory_order_relaxed) > 0;
+    });
+    // При остановке очереди дорабатываются до конца
+    if (stop_ && queued_.load(std::memory_order_relaxed) == 0) return;
+  }
+}
+
+void JobScheduler::RunLoop(LoopState &state) {
+  for (size_t i = state.next.fetch_add(1); i < state.count;
+       i = state.next.fetch_add(1)) {
+    if (state.group && state.group->IsCancelled()) {
+      // Остальные итерации больше никому не выдаются
+      state.next.store(state.count);
+      return;
+    }
+    state.body(i);
+  }
+}
+
+void JobScheduler::RunLoopHelper(const std::shared_ptr<LoopState> &state) {
+  // running растёт до взятия итерации: вызывающий поток дождётся всех,
+  // кто успел её получить; опоздавшие получат индекс за пределом
+  state->running.fetch_add(1);
+  RunLoop(*state);
+  if (state->running.fetch_sub(1) == 1) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->idle.notify_all();
+  }
+}
+
+void JobScheduler::ParallelForImpl(size_t count, unsigned max_threads,
+                                   std::function<void(size_t)> body,
+                                   TaskGroup *group) {
+  auto state = std::make_shared<LoopState>();
+  state->count = count;
+  state->body = std::move(body);
+  state->group = group;
+
+  const size_t helpers =
+      std::min<size_t>({count, max_threads, WorkerCount() + size_t(1)}) - 1;
+  const JobPriority priority = CurrentPriority();
+  for (size_t h = 0; h < helpers; ++h)
+    Submit([this, state] { RunLoopHelper(state); }, priority);
+
+  RunLoop(*state);
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->idle.wait(lock, [&] { return state->running.load() == 0; });
+}
+
+}  // namespace s21
@@ -0,0 +1,156 @@
+#ifndef S21_CORE_JOB_SCHEDULER_H
+#define S21_CORE_JOB_SCHEDULER_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+// Приоритет задачи: свободный поток берёт сначала интерактивные задачи,
+// затем загрузку, затем экспорт
+enum class JobPriority {
+  kInteractive = 0,
+  kLoad = 1,
+  kExport = 2,
+};
+
+// Группа задач: ожидание завершения и кооперативная отмена. Ещё не
+// начатые задачи отменённой группы не запускаются; начатые могут
+// проверять IsCancelled() сами. Группа должна пережить свои задачи
+// (Wait() перед разрушением).
+class TaskGroup {
+ public:
+  TaskGroup() = default;
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+  ~TaskGroup() { Wait(); }
+
+  void Cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+  bool IsCancelled() const {
+    return cancelled_.load(std::memory_order_relaxed);
+  }
+  // Все ли задачи группы завершены (или отброшены)
+  bool Done() const { return pending_.load(std::memory_order_acquire) == 0; }
+  // Ждёт завершения; поток-исполнитель пула тем временем выполняет
+  // другие задачи, поэтому ожидание внутри задачи не блокирует пул
+  void Wait();
+
+ private:
+  friend class JobScheduler;
+  void Add() { pending_.fetch_add(1, std::memory_order_relaxed); }
+  void Finish();
+
+  std::atomic<size_t> pending_{0};
+  std::atomic<bool> cancelled_{false};
+  std::mutex mutex_;
+  std::condition_variable done_;
+};
+
+// Пул потоков с перехватом работы (work stealing), без зависимости от Qt.
+// У каждого исполнителя своя очередь на приоритет: свои задачи он берёт
+// с конца (LIFO — данные ещё в кэше), чужие перехватывает с начала.
+// Задачи извне попадают в общую очередь. Один пул на процесс (Global())
+// даёт предсказуемую загрузку: сколько бы тяжёлых работ ни шло разом,
+// активных потоков не больше числа ядер.
+class JobScheduler {
+ public:
+  // workers — число потоков пула; 0 — по числу ядер минус один
+  // (вызывающий поток участвует в ParallelFor сам)
+  explicit JobScheduler(unsigned workers = 0);
+  ~JobScheduler();
+  JobScheduler(const JobScheduler &) = delete;
+  JobScheduler &operator=(const JobScheduler &) = delete;
+
+  static JobScheduler &Global();
+
+  unsigned WorkerCount() const {
+    return static_cast<unsigned>(workers_.size());
+  }
+
+  void Submit(std::function<void()> fn,
+              JobPriority priority = JobPriority::kLoad,
+              TaskGroup *group = nullptr);
+
+  // fn(i) для i в [0, count) не более чем на max_threads потоках
+  // (0 — без ограничения). Вызывающий поток участвует, помощники берутся
+  // из пула с приоритетом текущей задачи; занятый пул не мешает завершить
+  // цикл: оставшиеся итерации выполнит вызывающий поток.
+  // Итерации отменённой группы не выдаются.
+  template <class Fn>
+  void ParallelFor(size_t count, unsigned max_threads, Fn &&fn,
+                   TaskGroup *group = nullptr);
+
+  // Выполняет одну задачу из очередей, если есть
+  bool TryRunOne();
+
+  // Приоритет задачи, выполняемой текущим потоком (вне пула — kInteractive)
+  static JobPriority CurrentPriority();
+
+ private:
+  struct Task {
+    std::function<void()> fn;
+    TaskGroup *group = nullptr;
+    JobPriority priority = JobPriority::kLoad;
+  };
+  static constexpr int kPriorities = 3;
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks[kPriorities];
+  };
+
+  // Общее состояние одного ParallelFor: переживает вызов, если помощник
+  // стартует уже после его завершения
+  struct LoopState {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> running{0};
+    size_t count = 0;
+    std::function<void(size_t)> body;
+    TaskGroup *group = nullptr;
+    std::mutex mutex;
+    std::condition_variable idle;
+  };
+
+  void WorkerMain(size_t index);
+  bool PopTask(size_t self, Task &out);
+  void Run(Task &task);
+  void RunLoopHelper(const std::shared_ptr<LoopState> &state);
+  static void RunLoop(LoopState &state);
+  void ParallelForImpl(size_t count, unsigned max_threads,
+                       std::function<void(size_t)> body, TaskGroup *group);
+
+  std::vector<std::unique_ptr<Queue>> queues_;  // [0] — общая, далее по потоку
+  std::vector<std::thread> workers_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<size_t> queued_{0};
+  bool stop_ = false;
+};
+
+template <class Fn>
+void JobScheduler::ParallelFor(size_t count, unsigned max_threads, Fn &&fn,
+                               TaskGroup *group) {
+  if (count == 0) return;
+  const size_t limit = max_threads == 0 ? WorkerCount() + 1 : max_threads;
+  if (std::min(count, limit) <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      if (group && group->IsCancelled()) return;
+      fn(i);
+    }
+    return;
+  }
+  ParallelForImpl(count, static_cast<unsigned>(limit),
+                  [&fn](size_t i) { fn(i); }, group);
+}
+
+}  // namespace s21
+
+#endif  // S21_CORE_JOB_SCHEDULER_H
@@ -0,0 +1,35 @@
+#ifndef S21_CORE_PARALLEL_H
+#define S21_CORE_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+#include "core/job_scheduler.h"
+
+namespace s21 {
+
+// Число аппаратных потоков (не меньше 1)
+inline unsigned HardwareThreads() {
+  const unsigned n = std::thread::hardware_concurrency();
+  return n == 0 ? 1u : n;
+}
+
+// 0 -> по числу ядер, иначе как есть
+inline unsigned ResolveThreadCount(unsigned requested) {
+  return requested == 0 ? HardwareThreads() : requested;
+}
+
+// Выполняет fn(i) для i в [0, count) не более чем на threads потоках
+// общего пула (JobScheduler::Global()); вызывающий поток тоже участвует.
+// Вложенные и одновременные циклы делят одни и те же потоки.
+template <class Fn>
+void ParallelFor(size_t count, unsigned threads, Fn &&fn) {
+  JobScheduler::Global().ParallelFor(count, std::max(1u, threads),
+                                     std::forward<Fn>(fn));
+}
+
+}  // namespace s21
+
+#endif  // S21_CORE_PARALLEL_H
@@ -1,11 +1,13 @@
 #include "mainwindow.h"
 
+#include <QCheckBox>
 #include <QColorDialog>
 #include <QComboBox>
 #include <QDoubleSpinBox>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QMetaObject>
 #include <QSettings>
 #include <QStandardPaths>
 #include <QtGlobal>
@@ -69,6 +71,16 @@ namespace s21
     ui_->zoomOutButton->setEnabled(false);
     ui_->resetButton->setEnabled(false);
 
+    {
+      // Бюджет кэша моделей в памяти, МБ
+      QSettings st("s21", "3DViewer");
+      const qulonglong budget_mb =
+          st.value("Cache/modelBudgetMB",
+                   qulonglong(ModelCache::kDefaultBudget >> 20))
+              .toULongLong();
+      controller_->SetModelCacheBudget(static_cast<size_t>(budget_mb) << 20);
+    }
+
     {
       QSettings st("s21", "3DViewer");
       RenderSettings settings = ui_->openGLWidget->settings();
@@ -94,6 +106,13 @@ namespace s21
         edge_type = 0;
       }
       ui_->edgeTypeCombo->setCurrentIndex(edge_type);
+      int wire_mode = settings.wireframeMode;
+      if (wire_mode < 0 || wire_mode > 3)
+      {
+        wire_mode = 0;
+      }
+      ui_->wireframeCombo->setCurrentIndex(wire_mode);
+      ui_->hiddenLinesCheck->setChecked(settings.hiddenLines);
     }
 
     {
@@ -116,28 +135,55 @@ namespace s21
             &MainWindow::HandleFileOpen);
 
     connect(ui_->rotateXbutton, &QPushButton::clicked, this, [this]()
-            { ui_->openGLWidget->RotateX(10.0F); });
+            { controller_->ApplyRotateX(10.0); });
 
     connect(ui_->rotateYbutton, &QPushButton::clicked, this, [this]()
-            { ui_->openGLWidget->RotateY(10.0F); });
+            { controller_->ApplyRotateY(10.0); });
 
     connect(ui_->rotateZbutton, &QPushButton::clicked, this, [this]()
-            { ui_->openGLWidget->RotateZ(10.0F); });
+            { controller_->ApplyRotateZ(10.0); });
 
     connect(ui_->zoomInButton, &QPushButton::clicked, this, [this]()
-            { ui_->openGLWidget->Scale(1.1F); });
+            { controller_->ApplyScale(1.1); });
 
     connect(ui_->zoomOutButton, &QPushButton::clicked, this, [this]()
-            { ui_->openGLWidget->Scale(0.9F); });
+            { controller_->ApplyScale(0.9); });
 
     connect(ui_->moveApplyButton, &QPushButton::clicked, this, [this]()
-            { ui_->openGLWidget->Translate(
-                  static_cast<float>(ui_->moveXSpin->value()),
-                  static_cast<float>(ui_->moveYSpin->value()),
-                  static_cast<float>(ui_->moveZSpin->value())); });
+            { controller_->ApplyTranslate(ui_->moveXSpin->value(),
+                                          ui_->moveYSpin->value(),
+                                          ui_->moveZSpin->value()); });
+
+    connect(ui_->resetButton, &QPushButton::clicked, controller_,
+            &Controller::ResetTransform);
+
+    // Мышь, колесо и запись GIF идут через то же состояние контроллера
+    connect(ui_->openGLWidget, &GLWidget::RotateRequested, this,
+            [this](int axis, double deg)
+            {
+              if (axis == 0)
+              {
+                controller_->ApplyRotateX(deg);
+              }
+              else if (axis == 1)
+              {
+                controller_->ApplyRotateY(deg);
+              }
+              else
+              {
+                controller_->ApplyRotateZ(deg);
+              }
+            });
+    connect(ui_->openGLWidget, &GLWidget::ScaleRequested, controller_,
+            &Controller::ApplyScale);
+    connect(ui_->openGLWidget, &GLWidget::TranslateRequested, controller_,
+            &Controller::ApplyTranslate);
+    connect(ui_->openGLWidget, &GLWidget::ResetTransformRequested,
+            controller_, &Controller::ResetTransform);
 
-    connect(ui_->resetButton, &QPushButton::clicked, ui_->openGLWidget,
-            &GLWidget::ResetTransform);
+    connect(controller_, &Controller::TransformChanged, this,
+            [this](const TransformState *state)
+            { ui_->openGLWidget->SetTransform(*state); });
 
     connect(ui_->vertexTypeCombo,
             QOverload<int>::of(&QComboBox::currentIndexChanged), this,
@@ -201,6 +247,8 @@ namespace s21
 
     ui_->projectionCombo->setCurrentIndex(defaults.projectionType);
     ui_->edgeTypeCombo->setCurrentIndex(defaults.edgeType);
+    ui_->wireframeCombo->setCurrentIndex(defaults.wireframeMode);
+    ui_->hiddenLinesCheck->setChecked(defaults.hiddenLines);
     ui_->edgeWidthSpin->setValue(defaults.edgeWidth);
     ui_->statusLabel->setText("Настройки сброшены к значениям по умолчанию"); });
 
@@ -215,6 +263,27 @@ namespace s21
               settings.Save(st);
             });
 
+    connect(ui_->wireframeCombo,
+            QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            [this](int index)
+            {
+              RenderSettings settings = ui_->openGLWidget->settings();
+              settings.wireframeMode = (index >= 0 && index <= 3) ? index : 0;
+              ui_->openGLWidget->SetSettings(settings);
+              QSettings st("s21", "3DViewer");
+              settings.Save(st);
+            });
+
+    connect(ui_->hiddenLinesCheck, &QCheckBox::toggled, this,
+            [this](bool checked)
+            {
+              RenderSettings settings = ui_->openGLWidget->settings();
+              settings.hiddenLines = checked;
+              ui_->openGLWidget->SetSettings(settings);
+              QSettings st("s21", "3DViewer");
+              settings.Save(st);
+            });
+
     connect(ui_->bgColorButton, &QPushButton::clicked, this, [this]()
             {
     if (!ui_->openGLWidget) {
@@ -384,14 +453,25 @@ namespace s21
       path += ".gif";
     }
 
-    const bool ok = SaveGif(frames, path, /*delayCs=*/10, /*loop=*/0,
-                            /*W=*/640, /*H=*/480);
-    if (ok) {
-      saveLastDirFromPath(path);
-    }
-
-    ui_->statusLabel->setText(ok ? "GIF сохранён"
-                                 : "Не удалось сохранить GIF");
+    // Кодирование — задача пула с низшим приоритетом: загрузка и
+    // интерактив её обгоняют. Кадры разделяются без копирования (QImage)
+    ui_->statusLabel->setText("Сохранение GIF…");
+    JobScheduler::Global().Submit(
+        [this, frames, path]() {
+          const bool ok = SaveGif(frames, path, /*delayCs=*/10, /*loop=*/0,
+                                  /*W=*/640, /*H=*/480);
+          QMetaObject::invokeMethod(
+              this,
+              [this, ok, path]() {
+                if (ok) {
+                  saveLastDirFromPath(path);
+                }
+                ui_->statusLabel->setText(ok ? "GIF сохранён"
+                                             : "Не удалось сохранить GIF");
+              },
+              Qt::QueuedConnection);
+        },
+        JobPriority::kExport, &exports_);
     recorder_->Clear(); });
 
     connect(recorder_, &FrameRecorder::Error, this,
@@ -410,17 +490,21 @@ namespace s21
 
     connect(
         controller_, &Controller::Loaded, this,
-        [this](const Model *model, std::vector<uint32_t> edges,
-               double total_ms)
+        [this](const ModelPtr &model, double total_ms)
         {
+          const ModelCache::Stats &cache =
+              controller_->model_cache().stats();
           ui_->statusLabel->setText(
-              QString("Вершин: %1\nРёбер (факт): %2\nЗагрузка+разбор+рёбра: %3 мс")
+              QString("Вершин: %1\nРёбер (факт): %2\nЗагрузка+разбор+рёбра: %3 мс"
+                      "\nКэш моделей: попаданий %4, промахов %5, %6 МБ")
                   .arg(model->GetNumVertices())
-                  .arg(edges.size() / 2)
-                  .arg(total_ms, 0, 'f', 1));
+                  .arg(model->GetNumEdges())
+                  .arg(total_ms, 0, 'f', 1)
+                  .arg(cache.hits)
+                  .arg(cache.misses)
+                  .arg(cache.bytes >> 20));
 
-          ui_->openGLWidget->SetModelAndEdges(model, std::move(edges));
-          ui_->openGLWidget->update();
+          ui_->openGLWidget->SetModel(model);
 
           ui_->rotateXbutton->setEnabled(true);
           ui_->rotateYbutton->setEnabled(true);
@@ -430,22 +514,36 @@ namespace s21
           ui_->resetButton->setEnabled(true);
         });
 
+    connect(controller_, &Controller::Progress, this,
+            [this](quint64 bytes, quint64 total)
+            {
+              const quint64 percent = total ? bytes * 100 / total : 0;
+              ui_->statusLabel->setText(QString("Загрузка… %1%").arg(percent));
+            });
+
+    // Модель рисуется по частям, пока файл ещё разбирается
+    connect(controller_, &Controller::ChunkLoaded, ui_->openGLWidget,
+            &GLWidget::AddLoadingChunk);
+
     connect(controller_, &Controller::Failed, this,
             [this](const QString &error)
             {
               ui_->statusLabel->setText("Ошибка: " + error);
+              // Уже показанные части несостоявшейся модели убираются
+              ui_->openGLWidget->SetModel(nullptr);
             });
 
     connect(controller_, &Controller::Updated, this,
-            [this](const Model *model, std::vector<uint32_t> edges)
+            [this](const ModelPtr &model)
             {
               ui_->statusLabel->setText(
                   QString("Вершин: %1\nРёбер (факт): %2")
                       .arg(model->GetNumVertices())
-                      .arg(edges.size() / 2));
+                      .arg(model->GetNumEdges()));
 
-              ui_->openGLWidget->SetModelAndEdges(model, std::move(edges));
-              ui_->openGLWidget->update();
+              // Запекание меняет только геометрию: рёбра не
+              // перезаливаются, вид не сбрасывается
+              ui_->openGLWidget->SyncModel(model);
             });
   }
 
@@ -32,6 +32,8 @@ namespace s21
     Ui::MainWindow *ui_ = nullptr;
     Controller *controller_ = nullptr;
     FrameRecorder *recorder_ = nullptr;
+    // Экспорт (GIF) в фоне; окно дожидается его при закрытии
+    TaskGroup exports_;
   };
 
 } // namespace s21
@@ -0,0 +1,317 @@
+#include "model/edge_builder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "core/parallel.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr uint64_t kEmptyKey = ~uint64_t(0);  // вырожденное ребро / пустой слот
+constexpr size_t kSmallInput = size_t(1) << 15;
+constexpr size_t kHashTableBudget = size_t(8) << 20;  // ~LLC: таблица в кэше
+constexpr unsigned kRadixBits = 11;
+constexpr size_t kRadixBuckets = size_t(1) << kRadixBits;
+// Окно отсева повторов в куске: таблица 1 МБ живёт в L2
+constexpr size_t kWindowKeys = size_t(1) << 16;
+
+// Ключ (min << bits) | max: ширина по числу вершин, меньше проходов сортировки
+struct KeyPacking {
+  unsigned bits = 1;
+  uint64_t mask = 1;
+
+  explicit KeyPacking(size_t num_vertices) {
+    while (bits < 32 && (uint64_t(1) << bits) < num_vertices) ++bits;
+    mask = (uint64_t(1) << bits) - 1;
+  }
+  uint64_t Pack(uint32_t a, uint32_t b) const {
+    if (a > b) std::swap(a, b);
+    return (uint64_t(a) << bits) | b;
+  }
+  uint32_t First(uint64_t k) const { return static_cast<uint32_t>(k >> bits); }
+  uint32_t Second(uint64_t k) const {
+    return static_cast<uint32_t>(k & mask);
+  }
+};
+
+// Непрерывные диапазоны [begin, end) для блоков параллельной обработки
+struct Blocks {
+  size_t count, n;
+  Blocks(size_t n_items, size_t n_blocks)
+      : count(std::max<size_t>(1, std::min(n_items, n_blocks))), n(n_items) {}
+  size_t Begin(size_t i) const { return n * i / count; }
+  size_t End(size_t i) const { return n * (i + 1) / count; }
+};
+
+inline size_t NextPow2(size_t v) {
+  size_t p = 1;
+  while (p < v) p <<= 1;
+  return p;
+}
+
+inline uint64_t Mix64(uint64_t k) {
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+// Ключ на каждую позицию индекса: ребро (i, i+1) грани лежит в keys[offs + i]
+void BuildKeys(const std::vector<uint32_t> &offsets,
+               const std::vector<uint32_t> &indices, const KeyPacking &pack,
+               unsigned threads, std::vector<uint64_t> &keys) {
+  keys.resize(indices.size());
+  const size_t faces = offsets.empty() ? 0 : offsets.size() - 1;
+  const Blocks blocks(faces, size_t(threads) * 4);
+  ParallelFor(blocks.count, threads, [&](size_t b) {
+    for (size_t f = blocks.Begin(b); f < blocks.End(b); ++f) {
+      const uint32_t lo = offsets[f], hi = offsets[f + 1];
+      const uint32_t n = hi - lo;
+      for (uint32_t i = 0; i < n; ++i) {
+        const uint32_t a = indices[lo + i];
+        const uint32_t c = indices[lo + (i + 1 == n ? 0 : i + 1)];
+        keys[lo + i] = (n < 2 || a == c) ? kEmptyKey : pack.Pack(a, c);
+      }
+    }
+  });
+}
+
+void RadixSort(std::vector<uint64_t> &keys, unsigned key_bits,
+               unsigned threads) {
+  std::vector<uint64_t> tmp(keys.size());
+  const Blocks blocks(keys.size(), threads);
+  std::vector<size_t> hist(blocks.count * kRadixBuckets);
+
+  for (unsigned shift = 0; shift < key_bits; shift += kRadixBits) {
+    std::fill(hist.begin(), hist.end(), 0);
+    ParallelFor(blocks.count, threads, [&](size_t b) {
+      size_t *h = &hist[b * kRadixBuckets];
+      for (size_t i = blocks.Begin(b); i < blocks.End(b); ++i)
+        ++h[(keys[i] >> shift) & (kRadixBuckets - 1)];
+    });
+
+    // Все ключи в одной корзине — проход ничего не меняет
+    bool trivial = false;
+    for (size_t d = 0; d < kRadixBuckets && !trivial; ++d) {
+      size_t total = 0;
+      for (size_t b = 0; b < blocks.count; ++b)
+        total += hist[b * kRadixBuckets + d];
+      trivial = total == keys.size();
+    }
+    if (trivial) continue;
+
+    // Стабильный порядок: корзина d, внутри — блоки по возрастанию
+    size_t running = 0;
+    for (size_t d = 0; d < kRadixBuckets; ++d)
+      for (size_t b = 0; b < blocks.count; ++b) {
+        const size_t c = hist[b * kRadixBuckets + d];
+        hist[b * kRadixBuckets + d] = running;
+        running += c;
+      }
+
+    ParallelFor(blocks.count, threads, [&](size_t b) {
+      size_t *pos = &hist[b * kRadixBuckets];
+      for (size_t i = blocks.Begin(b); i < blocks.End(b); ++i)
+        tmp[pos[(keys[i] >> shift) & (kRadixBuckets - 1)]++] = keys[i];
+    });
+    keys.swap(tmp);
+  }
+}
+
+// Из отсортированных ключей — уникальные пары; kEmptyKey стоят в конце
+size_t EmitSortedUnique(const std::vector<uint64_t> &keys,
+                        const KeyPacking &pack, unsigned threads,
+                        std::vector<uint32_t> &out) {
+  const size_t n = static_cast<size_t>(
+      std::lower_bound(keys.begin(), keys.end(), kEmptyKey) - keys.begin());
+  const Blocks blocks(n, threads);
+  std::vector<size_t> first(blocks.count + 1, 0);
+
+  auto is_new = [&](size_t i) { return i == 0 || keys[i] != keys[i - 1]; };
+  ParallelFor(blocks.count, threads, [&](size_t b) {
+    size_t c = 0;
+    for (size_t i = blocks.Begin(b); i < blocks.End(b); ++i) c += is_new(i);
+    first[b + 1] = c;
+  });
+  for (size_t b = 0; b < blocks.count; ++b) first[b + 1] += first[b];
+
+  out.resize(first[blocks.count] * 2);
+  ParallelFor(blocks.count, threads, [&](size_t b) {
+    size_t w = first[b] * 2;
+    for (size_t i = blocks.Begin(b); i < blocks.End(b); ++i)
+      if (is_new(i)) {
+        out[w++] = pack.First(keys[i]);
+        out[w++] = pack.Second(keys[i]);
+      }
+  });
+  return first[blocks.count];
+}
+
+size_t UniqueByHashSet(const std::vector<uint64_t> &keys,
+                       const KeyPacking &pack, unsigned threads,
+                       std::vector<uint32_t> &out) {
+  // Заполнение не выше 2/3 даже если все рёбра уникальны
+  const size_t size = NextPow2(keys.size() + keys.size() / 2 + 1);
+  const size_t mask = size - 1;
+  std::unique_ptr<std::atomic<uint64_t>[]> table(
+      new std::atomic<uint64_t>[size]);
+
+  const Blocks slots(size, size_t(threads) * 4);
+  ParallelFor(slots.count, threads, [&](size_t b) {
+    for (size_t i = slots.Begin(b); i < slots.End(b); ++i)
+      table[i].store(kEmptyKey, std::memory_order_relaxed);
+  });
+
+  const Blocks blocks(keys.size(), size_t(threads) * 4);
+  ParallelFor(blocks.count, threads, [&](size_t b) {
+    for (size_t k = blocks.Begin(b); k < blocks.End(b); ++k) {
+      const uint64_t key = keys[k];
+      if (key == kEmptyKey) continue;
+      for (size_t i = Mix64(key) & mask;; i = (i + 1) & mask) {
+        uint64_t cur = table[i].load(std::memory_order_relaxed);
+        if (cur == kEmptyKey &&
+            table[i].compare_exchange_strong(cur, key,
+                                             std::memory_order_relaxed))
+          break;
+        if (cur == key) break;
+      }
+    }
+  });
+
+  std::vector<size_t> first(slots.count + 1, 0);
+  ParallelFor(slots.count, threads, [&](size_t b) {
+    size_t c = 0;
+    for (size_t i = slots.Begin(b); i < slots.End(b); ++i)
+      c += table[i].load(std::memory_order_relaxed) != kEmptyKey;
+    first[b + 1] = c;
+  });
+  for (size_t b = 0; b < slots.count; ++b) first[b + 1] += first[b];
+
+  out.resize(first[slots.count] * 2);
+  ParallelFor(slots.count, threads, [&](size_t b) {
+    size_t w = first[b] * 2;
+    for (size_t i = slots.Begin(b); i < slots.End(b); ++i) {
+      const uint64_t key = table[i].load(std::memory_order_relaxed);
+      if (key == kEmptyKey) continue;
+      out[w++] = pack.First(key);
+      out[w++] = pack.Second(key);
+    }
+  });
+  return first[slots.count];
+}
+
+size_t UniqueFromKeys(std::vector<uint64_t> &keys, const KeyPacking &pack,
+                      EdgeStrategy strategy, unsigned threads,
+                      std::vector<uint32_t> &out) {
+  if (strategy == EdgeStrategy::kAuto)
+    strategy = ChooseEdgeStrategy(keys.size(), threads);
+
+  switch (strategy) {
+    case EdgeStrategy::kHashSet:
+      return UniqueByHashSet(keys, pack, threads, out);
+    case EdgeStrategy::kRadixSort:
+      RadixSort(keys, 2 * pack.bits, threads);
+      return EmitSortedUnique(keys, pack, threads, out);
+    default:
+      std::sort(keys.begin(), keys.end());
+      return EmitSortedUnique(keys, pack, 1, out);
+  }
+}
+
+}  // namespace
+
+EdgeStrategy ChooseEdgeStrategy(size_t num_keys, unsigned threads) {
+  if (num_keys < kSmallInput) return EdgeStrategy::kSort;
+  // Таблица помещается в кэш последнего уровня — случайный доступ дёшев;
+  // дальше выигрывает потоковая поразрядная сортировка
+  const size_t table_bytes =
+      NextPow2(num_keys + num_keys / 2 + 1) * sizeof(uint64_t);
+  if (threads > 1 && table_bytes <= kHashTableBudget)
+    return EdgeStrategy::kHashSet;
+  return EdgeStrategy::kRadixSort;
+}
+
+size_t ExtractUniqueEdges(const std::vector<uint32_t> &face_offsets,
+                          const std::vector<uint32_t> &face_indices,
+                          size_t num_vertices, std::vector<uint32_t> &out,
+                          const EdgeBuildOptions &options) {
+  out.clear();
+  if (face_offsets.size() < 2 || face_indices.empty()) return 0;
+
+  const unsigned threads = ResolveThreadCount(options.threads);
+  const KeyPacking pack(num_vertices);
+
+  std::vector<uint64_t> keys;
+  BuildKeys(face_offsets, face_indices, pack, threads, keys);
+  return UniqueFromKeys(keys, pack, options.strategy, threads, out);
+}
+
+void AppendChunkEdgeKeys(const uint32_t *face_ends, size_t faces,
+                         const uint32_t *indices, size_t num_vertices,
+                         std::vector<uint64_t> &keys) {
+  const KeyPacking pack(num_vertices);
+  // Маленькая таблица с открытой адресацией, очищается каждые kWindowKeys
+  // ключей: общие рёбра соседних граней почти всегда попадают в одно окно
+  std::vector<uint64_t> table(2 * kWindowKeys, kEmptyKey);
+  const size_t mask = table.size() - 1;
+  size_t used = 0;
+
+  uint32_t lo = 0;
+  for (size_t f = 0; f < faces; ++f) {
+    const uint32_t hi = face_ends[f];
+    const uint32_t n = hi - lo;
+    for (uint32_t i = 0; n >= 2 && i < n; ++i) {
+      const uint32_t a = indices[lo + i];
+      const uint32_t c = indices[lo + (i + 1 == n ? 0 : i + 1)];
+      if (a == c) continue;
+      const uint64_t key = pack.Pack(a, c);
+      size_t slot = Mix64(key) & mask;
+      while (table[slot] != kEmptyKey && table[slot] != key)
+        slot = (slot + 1) & mask;
+      if (table[slot] == key) continue;
+      keys.push_back(key);
+      table[slot] = key;
+      if (++used == kWindowKeys) {
+        std::fill(table.begin(), table.end(), kEmptyKey);
+        used = 0;
+      }
+    }
+    lo = hi;
+  }
+}
+
+void EdgeKeysToPairs(const std::vector<uint64_t> &keys, size_t num_vertices,
+                     std::vector<uint32_t> &out) {
+  const KeyPacking pack(num_vertices);
+  out.reserve(out.size() + keys.size() * 2);
+  for (const uint64_t key : keys) {
+    out.push_back(pack.First(key));
+    out.push_back(pack.Second(key));
+  }
+}
+
+size_t UniqueEdgesFromKeys(const std::vector<std::vector<uint64_t>> &parts,
+                           size_t num_vertices, std::vector<uint32_t> &out,
+                           const EdgeBuildOptions &options) {
+  out.clear();
+  std::vector<size_t> base(parts.size() + 1, 0);
+  for (size_t i = 0; i < parts.size(); ++i)
+    base[i + 1] = base[i] + parts[i].size();
+  if (base.back() == 0) return 0;
+
+  const unsigned threads = ResolveThreadCount(options.threads);
+  std::vector<uint64_t> keys(base.back());
+  ParallelFor(parts.size(), threads, [&](size_t i) {
+    std::copy(parts[i].begin(), parts[i].end(),
+              keys.begin() + static_cast<std::ptrdiff_t>(base[i]));
+  });
+  return UniqueFromKeys(keys, KeyPacking(num_vertices), options.strategy,
+                        threads, out);
+}
+
+}  // namespace s21
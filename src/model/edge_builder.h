@@ -0,0 +1,57 @@
+#ifndef S21_EDGE_BUILDER_H
+#define S21_EDGE_BUILDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace s21 {
+
+enum class EdgeStrategy {
+  kAuto,       // выбор по размеру входа
+  kSort,       // std::sort, для маленьких моделей
+  kRadixSort,  // параллельная LSD-поразрядная сортировка
+  kHashSet,    // конкурентная хэш-таблица с открытой адресацией
+};
+
+struct EdgeBuildOptions {
+  EdgeStrategy strategy = EdgeStrategy::kAuto;
+  unsigned threads = 0;  // 0 — по числу ядер
+};
+
+// Уникальные рёбра всех граней из CSR-топологии (offsets: F + 1 или пусто).
+// Ребро — пара (min, max), вырожденные a == b отбрасываются.
+// out — пары индексов для GL_LINES; возвращает число уникальных рёбер.
+// При kSort/kRadixSort пары упорядочены, при kHashSet порядок произвольный.
+size_t ExtractUniqueEdges(const std::vector<uint32_t> &face_offsets,
+                          const std::vector<uint32_t> &face_indices,
+                          size_t num_vertices, std::vector<uint32_t> &out,
+                          const EdgeBuildOptions &options = {});
+
+// Потоковый вариант для конвейера загрузки: ключи рёбер собираются
+// по кускам граней, как только кусок разобран, а уникальность по всей
+// модели доводится одним проходом в конце.
+//
+// Ключи рёбер куска (локальный CSR: face_ends — конец каждой грани
+// в indices) дописываются в keys. Повторы среди соседних граней
+// отбрасываются сразу, поэтому ключей обычно вдвое меньше, чем индексов.
+void AppendChunkEdgeKeys(const uint32_t *face_ends, size_t faces,
+                         const uint32_t *indices, size_t num_vertices,
+                         std::vector<uint64_t> &keys);
+
+// Ключи обратно в пары индексов для GL_LINES (дописываются в out)
+void EdgeKeysToPairs(const std::vector<uint64_t> &keys, size_t num_vertices,
+                     std::vector<uint32_t> &out);
+
+// Уникальные рёбра по ключам всех кусков (num_vertices — тот же, что при
+// сборе ключей); результат как у ExtractUniqueEdges
+size_t UniqueEdgesFromKeys(const std::vector<std::vector<uint64_t>> &parts,
+                           size_t num_vertices, std::vector<uint32_t> &out,
+                           const EdgeBuildOptions &options = {});
+
+// Стратегия, которую выберет kAuto для заданного числа ключей
+EdgeStrategy ChooseEdgeStrategy(size_t num_keys, unsigned threads);
+
+}  // namespace s21
+
+#endif  // S21_EDGE_BUILDER_H
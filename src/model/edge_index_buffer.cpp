@@ -0,0 +1,261 @@
+#include "model/edge_index_buffer.h"
+
+#include <algorithm>
+
+#include "core/parallel.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr size_t kNarrowLimit = size_t(1) << 16;  // вершин в 16-битном окне
+constexpr size_t kMinBlockEdges = size_t(1) << 14;
+
+// Непрерывные диапазоны рёбер для блоков параллельной обработки
+size_t BlockBegin(size_t n, size_t blocks, size_t b) { return n * b / blocks; }
+
+// Блоков на n рёбер или граней: не мельче kMinBlockEdges, по 4 на поток
+size_t BlockCount(size_t n, unsigned threads) {
+  return std::max<size_t>(1, std::min(n / kMinBlockEdges, size_t(threads) * 4));
+}
+
+// Окно ребра (a, b): 0..windows-1 — 16-битный пакет, windows — 32-битная
+// часть. Одно окно — вся модель (база 0), ни одного — всё 32-битное.
+size_t WindowOf(uint32_t a, uint32_t b, size_t windows) {
+  if (windows <= 1) return 0;
+  const uint32_t lo = std::min(a, b), hi = std::max(a, b);
+  const size_t w = lo / kEdgeWindowStep;
+  return hi - w * kEdgeWindowStep < kNarrowLimit ? w : windows;
+}
+
+}  // namespace
+
+EdgeIndexLayout PlanEdgeIndices(const std::vector<uint32_t> &edges,
+                                size_t num_vertices, bool base_vertex,
+                                unsigned threads) {
+  EdgeIndexLayout layout;
+  const size_t n = edges.size() / 2;
+  if (n == 0) return layout;
+
+  // Без базовой вершины крупная модель — только 32-битная часть
+  if (num_vertices <= kNarrowLimit)
+    layout.windows = 1;
+  else if (base_vertex)
+    layout.windows = (num_vertices + kEdgeWindowStep - 1) / kEdgeWindowStep;
+  const size_t windows = layout.windows;
+  const size_t slots = windows + 1;
+
+  threads = ResolveThreadCount(threads);
+  layout.blocks = BlockCount(n, threads);
+  const size_t blocks = layout.blocks;
+  std::vector<size_t> &hist = layout.block_offsets;
+  hist.assign(blocks * slots, 0);
+
+  ParallelFor(blocks, threads, [&](size_t b) {
+    size_t *h = &hist[b * slots];
+    for (size_t e = BlockBegin(n, blocks, b); e < BlockBegin(n, blocks, b + 1);
+         ++e)
+      ++h[WindowOf(edges[2 * e], edges[2 * e + 1], windows)];
+  });
+
+  // Окна по порядку, внутри окна — блоки по порядку: каждый блок пишет
+  // в свой непрерывный участок пакета
+  size_t narrow = 0;
+  for (size_t w = 0; w < windows; ++w) {
+    const size_t start = narrow;
+    for (size_t b = 0; b < blocks; ++b) {
+      const size_t c = hist[b * slots + w];
+      hist[b * slots + w] = narrow;
+      narrow += c;
+    }
+    if (narrow == start) continue;
+    EdgeIndexBatch batch;
+    batch.base_vertex =
+        windows > 1 ? static_cast<uint32_t>(w * kEdgeWindowStep) : 0;
+    batch.first = start * 2;
+    batch.count = (narrow - start) * 2;
+    layout.batches.push_back(batch);
+  }
+  size_t wide = 0;
+  for (size_t b = 0; b < blocks; ++b) {
+    const size_t c = hist[b * slots + windows];
+    hist[b * slots + windows] = wide;
+    wide += c;
+  }
+
+  layout.narrow_count = narrow * 2;
+  layout.wide_offset =
+      (layout.narrow_count * sizeof(uint16_t) + 3) & ~size_t(3);
+  layout.wide_count = wide * 2;
+  layout.bytes = layout.wide_offset + layout.wide_count * sizeof(uint32_t);
+  return layout;
+}
+
+void WriteEdgeIndices(const std::vector<uint32_t> &edges,
+                      const EdgeIndexLayout &layout, void *dst,
+                      unsigned threads) {
+  const size_t n = edges.size() / 2;
+  if (n == 0 || layout.bytes == 0) return;
+  uint16_t *narrow = static_cast<uint16_t *>(dst);
+  uint32_t *wide = reinterpret_cast<uint32_t *>(static_cast<char *>(dst) +
+                                                layout.wide_offset);
+  const size_t windows = layout.windows;
+  const size_t slots = windows + 1;
+  const size_t blocks = layout.blocks;
+  const bool based = windows > 1;
+
+  ParallelFor(blocks, ResolveThreadCount(threads), [&](size_t b) {
+    std::vector<size_t> pos(layout.block_offsets.begin() +
+                                static_cast<std::ptrdiff_t>(b * slots),
+                            layout.block_offsets.begin() +
+                                static_cast<std::ptrdiff_t>((b + 1) * slots));
+    for (size_t e = BlockBegin(n, blocks, b); e < BlockBegin(n, blocks, b + 1);
+         ++e) {
+      const uint32_t a = edges[2 * e], c = edges[2 * e + 1];
+      const size_t w = WindowOf(a, c, windows);
+      const size_t p = pos[w]++;
+      if (w == windows) {
+        wide[2 * p] = a;
+        wide[2 * p + 1] = c;
+      } else {
+        const uint32_t base =
+            based ? static_cast<uint32_t>(w * kEdgeWindowStep) : 0;
+        narrow[2 * p] = static_cast<uint16_t>(a - base);
+        narrow[2 * p + 1] = static_cast<uint16_t>(c - base);
+      }
+    }
+  });
+}
+
+FaceLoopLayout PlanFaceLoops(const std::vector<uint32_t> &face_offsets,
+                             size_t num_vertices) {
+  FaceLoopLayout layout;
+  if (face_offsets.size() < 2) return layout;
+  const size_t faces = face_offsets.size() - 1;
+  // 0xFFFF занят перезапуском: 16 бит — только если вершин меньше
+  layout.narrow = num_vertices < kNarrowLimit;
+  layout.count = face_offsets.back() + faces;
+  layout.bytes =
+      layout.count * (layout.narrow ? sizeof(uint16_t) : sizeof(uint32_t));
+  return layout;
+}
+
+namespace {
+
+// Грань i начинается с offsets[i] + i: перед ней i перезапусков
+template <class Index>
+void WriteLoops(const std::vector<uint32_t> &offsets,
+                const std::vector<uint32_t> &indices, Index restart,
+                Index *dst, unsigned threads) {
+  const size_t faces = offsets.size() - 1;
+  const size_t blocks = BlockCount(faces, threads);
+  ParallelFor(blocks, threads, [&](size_t b) {
+    const size_t end = BlockBegin(faces, blocks, b + 1);
+    for (size_t f = BlockBegin(faces, blocks, b); f < end; ++f) {
+      Index *out = dst + offsets[f] + f;
+      for (uint32_t k = offsets[f]; k < offsets[f + 1]; ++k)
+        *out++ = static_cast<Index>(indices[k]);
+      *out = restart;
+    }
+  });
+}
+
+}  // namespace
+
+void WriteFaceLoops(const std::vector<uint32_t> &face_offsets,
+                    const std::vector<uint32_t> &face_indices,
+                    const FaceLoopLayout &layout, void *dst,
+                    unsigned threads) {
+  if (layout.count == 0) return;
+  threads = ResolveThreadCount(threads);
+  if (layout.narrow)
+    WriteLoops(face_offsets, face_indices,
+               static_cast<uint16_t>(layout.RestartIndex()),
+               static_cast<uint16_t *>(dst), threads);
+  else
+    WriteLoops(face_offsets, face_indices, layout.RestartIndex(),
+               static_cast<uint32_t *>(dst), threads);
+}
+
+namespace {
+
+// Веер грани из n вершин: треугольники (p0, p[k+1], p[k+2]), k < n - 2.
+// Сторона напротив p0 — всегда ребро грани, напротив p[k+1] — только у
+// последнего, напротив p[k+2] — только у первого
+template <class Index>
+void WriteFans(const std::vector<uint32_t> &offsets,
+               const std::vector<uint32_t> &indices,
+               const WireTriangleLayout &layout, Index *dst, uint8_t *masks,
+               unsigned threads) {
+  const size_t faces = offsets.size() - 1;
+  const size_t blocks = layout.blocks;
+  ParallelFor(blocks, threads, [&](size_t b) {
+    size_t t = layout.block_first[b];
+    const size_t end = BlockBegin(faces, blocks, b + 1);
+    for (size_t f = BlockBegin(faces, blocks, b); f < end; ++f) {
+      const uint32_t *p = indices.data() + offsets[f];
+      const size_t n = offsets[f + 1] - offsets[f];
+      for (size_t k = 0; k + 2 < n; ++k, ++t) {
+        dst[3 * t] = static_cast<Index>(p[0]);
+        dst[3 * t + 1] = static_cast<Index>(p[k + 1]);
+        dst[3 * t + 2] = static_cast<Index>(p[k + 2]);
+        if (masks)
+          masks[t] = static_cast<uint8_t>(1u | (k + 3 == n ? 2u : 0u) |
+                                          (k == 0 ? 4u : 0u));
+      }
+    }
+  });
+}
+
+}  // namespace
+
+WireTriangleLayout PlanWireTriangles(const std::vector<uint32_t> &face_offsets,
+                                     size_t num_vertices, unsigned threads) {
+  WireTriangleLayout layout;
+  if (face_offsets.size() < 2) return layout;
+  const size_t faces = face_offsets.size() - 1;
+  threads = ResolveThreadCount(threads);
+  layout.blocks = BlockCount(faces, threads);
+  const size_t blocks = layout.blocks;
+
+  // Треугольников и граней больше трёх вершин в каждом блоке
+  std::vector<size_t> tris(blocks, 0), polys(blocks, 0);
+  ParallelFor(blocks, threads, [&](size_t b) {
+    const size_t end = BlockBegin(faces, blocks, b + 1);
+    for (size_t f = BlockBegin(faces, blocks, b); f < end; ++f) {
+      const size_t n = face_offsets[f + 1] - face_offsets[f];
+      if (n >= 3) tris[b] += n - 2;
+      if (n > 3) ++polys[b];
+    }
+  });
+
+  layout.block_first.resize(blocks);
+  size_t total = 0, total_polys = 0;
+  for (size_t b = 0; b < blocks; ++b) {
+    layout.block_first[b] = total;
+    total += tris[b];
+    total_polys += polys[b];
+  }
+  layout.triangles = total;
+  layout.all_edges = total_polys == 0;
+  layout.narrow = num_vertices <= kNarrowLimit;
+  layout.bytes =
+      3 * total * (layout.narrow ? sizeof(uint16_t) : sizeof(uint32_t));
+  return layout;
+}
+
+void WriteWireTriangles(const std::vector<uint32_t> &face_offsets,
+                        const std::vector<uint32_t> &face_indices,
+                        const WireTriangleLayout &layout, void *dst,
+                        uint8_t *masks, unsigned threads) {
+  if (layout.triangles == 0) return;
+  threads = ResolveThreadCount(threads);
+  if (layout.narrow)
+    WriteFans(face_offsets, face_indices, layout, static_cast<uint16_t *>(dst),
+              masks, threads);
+  else
+    WriteFans(face_offsets, face_indices, layout, static_cast<uint32_t *>(dst),
+              masks, threads);
+}
+
+}  // namespace s21
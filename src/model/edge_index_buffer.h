@@ -0,0 +1,105 @@
+#ifndef S21_EDGE_INDEX_BUFFER_H
+#define S21_EDGE_INDEX_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Раскладка индексов рёбер для GPU. Индексы по возможности 16-битные:
+// модель до 65 536 вершин — один пакет с базой 0; модель крупнее
+// делится на окна вершин, и пакет окна рисуется с базовой вершиной
+// (glDrawElementsBaseVertex) и локальными индексами. Рёбра, концы
+// которых не помещаются в одно окно, остаются 32-битными в хвосте буфера.
+
+namespace s21 {
+
+struct EdgeIndexBatch {
+  uint32_t base_vertex = 0;
+  size_t first = 0;  // номер первого 16-битного индекса пакета
+  size_t count = 0;  // индексов в пакете (по два на ребро)
+};
+
+struct EdgeIndexLayout {
+  std::vector<EdgeIndexBatch> batches;
+  size_t narrow_count = 0;  // 16-битных индексов всего
+  size_t wide_offset = 0;   // байтовое смещение 32-битной части (кратно 4)
+  size_t wide_count = 0;    // 32-битных индексов
+  size_t bytes = 0;         // размер всего буфера
+
+  // Для записи: куда блок b кладёт рёбра окна w (в рёбрах от начала
+  // своей части); окно windows — 32-битная часть
+  size_t windows = 0;
+  size_t blocks = 0;
+  std::vector<size_t> block_offsets;
+};
+
+// Шаг окон; окно охватывает две шага, поэтому в 16 бит попадает любое
+// ребро короче шага
+constexpr size_t kEdgeWindowStep = size_t(1) << 15;
+
+// Раскладка для пар индексов edges (GL_LINES) модели из num_vertices
+// вершин. base_vertex == false — базовая вершина недоступна: модели
+// крупнее 65 536 вершин целиком 32-битные.
+EdgeIndexLayout PlanEdgeIndices(const std::vector<uint32_t> &edges,
+                                size_t num_vertices, bool base_vertex = true,
+                                unsigned threads = 0);
+
+// Пишет индексы по раскладке в dst (layout.bytes байт, например
+// отображённый буфер GL), параллельно по блокам
+void WriteEdgeIndices(const std::vector<uint32_t> &edges,
+                      const EdgeIndexLayout &layout, void *dst,
+                      unsigned threads = 0);
+
+// Каркас контурами граней: GL_LINE_LOOP на грань, грани разделены
+// индексом перезапуска примитива. Грань из n вершин — n + 1 индекс
+// (рёбра, общие для двух граней, рисуются дважды), зато без списка
+// уникальных рёбер; выгоднее GL_LINES на крупных многоугольниках.
+struct FaceLoopLayout {
+  bool narrow = false;  // 16-битные индексы
+  size_t count = 0;     // индексов, включая перезапуски
+  size_t bytes = 0;
+  // Индекс перезапуска: наибольшее значение типа индекса
+  uint32_t RestartIndex() const { return narrow ? 0xFFFFu : 0xFFFFFFFFu; }
+};
+
+// Раскладка контуров для граней в CSR (face_offsets — F + 1 элементов)
+// модели из num_vertices вершин
+FaceLoopLayout PlanFaceLoops(const std::vector<uint32_t> &face_offsets,
+                             size_t num_vertices);
+
+// Пишет контуры по раскладке в dst (layout.bytes байт), параллельно
+// по блокам граней
+void WriteFaceLoops(const std::vector<uint32_t> &face_offsets,
+                    const std::vector<uint32_t> &face_indices,
+                    const FaceLoopLayout &layout, void *dst,
+                    unsigned threads = 0);
+
+// Каркас без буфера рёбер: грани веером режутся на треугольники
+// (GL_TRIANGLES), рёбра рисует шейдер по расстоянию до сторон. Маска
+// треугольника — какие стороны настоящие рёбра грани, а не диагонали
+// веера: бит i — сторона напротив вершины i. Грани меньше трёх вершин
+// в этом виде не рисуются.
+struct WireTriangleLayout {
+  bool narrow = false;     // 16-битные индексы
+  bool all_edges = false;  // все грани — треугольники: маска не нужна
+  size_t triangles = 0;
+  size_t bytes = 0;        // индексов: 3 * triangles
+  // Для записи: первый треугольник каждого блока граней
+  size_t blocks = 0;
+  std::vector<size_t> block_first;
+};
+
+WireTriangleLayout PlanWireTriangles(const std::vector<uint32_t> &face_offsets,
+                                     size_t num_vertices,
+                                     unsigned threads = 0);
+
+// Пишет индексы треугольников в dst (layout.bytes байт) и, если masks не
+// nullptr, маски (layout.triangles байт), параллельно по блокам граней
+void WriteWireTriangles(const std::vector<uint32_t> &face_offsets,
+                        const std::vector<uint32_t> &face_indices,
+                        const WireTriangleLayout &layout, void *dst,
+                        uint8_t *masks, unsigned threads = 0);
+
+}  // namespace s21
+
+#endif  // S21_EDGE_INDEX_BUFFER_H
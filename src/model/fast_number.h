@@ -0,0 +1,218 @@
+#ifndef S21_FAST_NUMBER_H
+#define S21_FAST_NUMBER_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+// Быстрый разбор чисел для горячих путей парсера OBJ.
+// Не зависит от локали (разделитель всегда '.') и не выходит за [p, end).
+// Результат совпадает с strtod: быстрый путь Клингера точен, всё прочее
+// уходит в from_chars / strtod.
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || \
+    defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+#define S21_FAST_NUMBER_SWAR 1
+#endif
+
+namespace s21 {
+
+namespace fast_number_detail {
+
+inline bool IsDigit(char c) {
+  return static_cast<unsigned char>(c - '0') < 10;
+}
+
+inline bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' ||
+         c == '\f';
+}
+
+#ifdef S21_FAST_NUMBER_SWAR
+// 8 ASCII-цифр в одном 64-битном слове (SWAR)
+inline bool IsEightDigits(uint64_t v) {
+  return (((v & 0xF0F0F0F0F0F0F0F0ULL) |
+           (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+          0x3333333333333333ULL);
+}
+
+inline uint32_t ParseEightDigits(uint64_t v) {
+  v = (v & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+  v = (v & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+  return static_cast<uint32_t>((v & 0x0000FFFF0000FFFFULL) *
+                                   42949672960001ULL >>
+                               32);
+}
+#endif
+
+// Мантисса до 19 значащих цифр; больше — признак для медленного пути
+struct Decimal {
+  uint64_t mantissa = 0;
+  int digits = 0;
+  bool truncated = false;
+};
+
+inline const char *AppendDigits(const char *p, const char *end, Decimal &d,
+                                int &count) {
+#ifdef S21_FAST_NUMBER_SWAR
+  while (end - p >= 8 && d.digits + 8 <= 19) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    if (!IsEightDigits(v)) break;
+    d.mantissa = d.mantissa * 100000000ULL + ParseEightDigits(v);
+    if (d.mantissa != 0) d.digits += 8;  // ведущие нули не значащие
+    p += 8;
+    count += 8;
+  }
+#endif
+  for (; p < end && IsDigit(*p); ++p, ++count) {
+    if (d.digits < 19) {
+      d.mantissa = d.mantissa * 10 + static_cast<uint64_t>(*p - '0');
+      if (d.mantissa != 0) ++d.digits;
+    } else {
+      d.truncated = true;
+    }
+  }
+  return p;
+}
+
+// Точные степени десяти для double
+inline double Pow10(int e) {
+  static constexpr double kPow10[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  return kPow10[e];
+}
+
+// Медленный путь: токен копируется, чтобы не читать за границей буфера
+inline double SlowParseDouble(const char *begin, const char *end,
+                              const char **out_end) {
+  const char *tok_end = begin;
+  while (tok_end < end && !IsSpace(*tok_end)) ++tok_end;
+  std::string tok(begin, tok_end);
+
+  double value = 0.0;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  const char *first = tok.c_str();
+  const char *last = first + tok.size();
+  const bool neg = first < last && *first == '-';
+  const char *digits =
+      first + ((first < last && (*first == '+' || neg)) ? 1 : 0);
+  if (digits < last && (IsDigit(*digits) || *digits == '.') &&
+      !(last - digits > 1 && digits[0] == '0' &&
+        (digits[1] == 'x' || digits[1] == 'X'))) {
+    auto res =
+        std::from_chars(digits, last, value, std::chars_format::general);
+    if (res.ec == std::errc()) {
+      *out_end = begin + (res.ptr - first);
+      return neg ? -value : value;
+    }
+  }
+#endif
+  // inf / nan / hex / выход за диапазон — ровно как strtod
+  char *e = nullptr;
+  value = std::strtod(tok.c_str(), &e);
+  *out_end = begin + (e - tok.c_str());
+  return value;
+}
+
+}  // namespace fast_number_detail
+
+// Разбирает double из [p, end). Пробелы перед числом не пропускаются.
+// Возвращает указатель за числом; если числа нет — p и out = 0.
+inline const char *ParseDouble(const char *p, const char *end, double &out) {
+  using namespace fast_number_detail;
+  const char *start = p;
+  out = 0.0;
+  if (p >= end) return p;
+
+  const bool neg = (*p == '-');
+  if (*p == '-' || *p == '+') ++p;
+  if (p >= end || !(IsDigit(*p) || *p == '.')) {
+    const char *e = start;
+    const double v = SlowParseDouble(start, end, &e);
+    if (e != start) out = v;
+    return e;
+  }
+
+  Decimal d;
+  int int_digits = 0, frac_digits = 0;
+  p = AppendDigits(p, end, d, int_digits);
+  if (int_digits == 1 && d.mantissa == 0 && p < end &&
+      (*p == 'x' || *p == 'X')) {
+    const char *e = start;  // шестнадцатеричная запись
+    out = SlowParseDouble(start, end, &e);
+    return e;
+  }
+  int exp10 = 0;
+  if (p < end && *p == '.') {
+    p = AppendDigits(p + 1, end, d, frac_digits);
+    exp10 -= frac_digits;
+  }
+  if (int_digits + frac_digits == 0) return start;  // "." или "-"
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    const char *q = p + 1;
+    bool exp_neg = false;
+    if (q < end && (*q == '-' || *q == '+')) exp_neg = (*q++ == '-');
+    if (q < end && IsDigit(*q)) {
+      int e = 0;
+      for (; q < end && IsDigit(*q); ++q)
+        if (e < 100000) e = e * 10 + (*q - '0');
+      exp10 += exp_neg ? -e : e;
+      p = q;
+    }
+  }
+
+  // Быстрый путь Клингера: мантисса и 10^|e| точны в double,
+  // одна операция IEEE даёт корректно округлённый результат
+  if (!d.truncated && d.mantissa <= (uint64_t(1) << 53) && exp10 >= -22 &&
+      exp10 <= 22) {
+    double v = static_cast<double>(d.mantissa);
+    v = exp10 < 0 ? v / Pow10(-exp10) : v * Pow10(exp10);
+    out = neg ? -v : v;
+    return p;
+  }
+  if (!d.truncated && d.mantissa == 0) {
+    out = neg ? -0.0 : 0.0;
+    return p;
+  }
+
+  const char *e = start;
+  out = SlowParseDouble(start, end, &e);
+  return e;
+}
+
+// Целое в стиле strtol(s, &e, 10) без пропуска пробелов; при
+// переполнении насыщается до пределов long.
+inline const char *ParseLong(const char *p, const char *end, long &out) {
+  using namespace fast_number_detail;
+  const char *start = p;
+  out = 0;
+  if (p >= end) return p;
+  const bool neg = (*p == '-');
+  if (*p == '-' || *p == '+') ++p;
+  if (p >= end || !IsDigit(*p)) return start;
+
+  constexpr uint64_t kLimit =
+      static_cast<uint64_t>(std::numeric_limits<long>::max());
+  uint64_t v = 0;
+  for (; p < end && IsDigit(*p); ++p) {
+    v = (v <= kLimit / 10) ? v * 10 + static_cast<uint64_t>(*p - '0')
+                           : kLimit + 1;
+  }
+  if (v > kLimit) {
+    out = neg ? std::numeric_limits<long>::min()
+              : std::numeric_limits<long>::max();
+  } else {
+    out = neg ? -static_cast<long>(v) : static_cast<long>(v);
+  }
+  return p;
+}
+
+}  // namespace s21
+
+#endif  // S21_FAST_NUMBER_H
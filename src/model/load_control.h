@@ -0,0 +1,92 @@
+#ifndef S21_LOAD_CONTROL_H
+#define S21_LOAD_CONTROL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Часть модели, готовая до конца загрузки: по ним модель показывается,
+// пока файл ещё разбирается. Кусок файла приходит дважды: сначала его
+// вершины (сразу после разбора), затем его рёбра. Куски приходят в любом
+// порядке; рёбра куска ссылаются только на вершины его и предыдущих.
+struct LoadedChunk {
+  enum class Kind { kVertices, kEdges };
+
+  Kind kind = Kind::kVertices;
+  size_t index = 0;           // номер куска в файле
+  size_t chunks = 0;          // всего кусков
+  size_t total_vertices = 0;  // вершин во всей модели
+  size_t first_vertex = 0;    // kVertices: номер первой вершины куска
+  std::vector<float> positions;  // kVertices: xyz вершин куска
+  // kEdges: пары индексов для GL_LINES; ребро на стыке кусков может
+  // прийти дважды — окончательный список рёбер будет в модели
+  std::vector<uint32_t> edges;
+};
+using LoadedChunkPtr = std::shared_ptr<const LoadedChunk>;
+
+// Отмена и прогресс одной загрузки. Загрузчик проверяет IsCancelled()
+// между порциями разбора и сообщает о разобранных байтах из рабочих
+// потоков; колбэк вызывается не чаще, чем раз на процент файла.
+class LoadControl {
+ public:
+  using ProgressFn = std::function<void(uint64_t bytes, uint64_t total)>;
+  using ChunkFn = std::function<void(LoadedChunkPtr chunk)>;
+
+  LoadControl() = default;
+  explicit LoadControl(ProgressFn progress) : progress_(std::move(progress)) {}
+
+  void Cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+  bool IsCancelled() const {
+    return cancelled_.load(std::memory_order_relaxed);
+  }
+
+  // Новая загрузка: total байт, счётчик с нуля
+  void Start(uint64_t total) {
+    total_ = total;
+    done_.store(0, std::memory_order_relaxed);
+    reported_.store(0, std::memory_order_relaxed);
+  }
+  // Ещё bytes разобрано; потокобезопасно
+  void Advance(uint64_t bytes) {
+    if (!progress_ || total_ == 0) return;
+    const uint64_t done =
+        std::min(total_, done_.fetch_add(bytes, std::memory_order_relaxed) +
+                             bytes);
+    // Ступень — процент файла; одну ступень сообщает один поток
+    const uint64_t step = std::max<uint64_t>(1, total_ / 100);
+    uint64_t last = reported_.load(std::memory_order_relaxed);
+    while (done / step > last / step || (done == total_ && last != total_)) {
+      if (reported_.compare_exchange_weak(last, done)) {
+        progress_(done, total_);
+        return;
+      }
+    }
+  }
+  void Finish() { Advance(total_); }
+
+  // Приёмник готовых частей модели (задаётся до начала загрузки);
+  // вызывается из рабочих потоков
+  void SetChunkSink(ChunkFn sink) { chunk_sink_ = std::move(sink); }
+  bool WantsChunks() const { return static_cast<bool>(chunk_sink_); }
+  void Deliver(LoadedChunkPtr chunk) const {
+    if (chunk_sink_) chunk_sink_(std::move(chunk));
+  }
+
+ private:
+  ProgressFn progress_;
+  ChunkFn chunk_sink_;
+  std::atomic<bool> cancelled_{false};
+  uint64_t total_ = 0;
+  std::atomic<uint64_t> done_{0};
+  std::atomic<uint64_t> reported_{0};
+};
+
+}  // namespace s21
+
+#endif  // S21_LOAD_CONTROL_H
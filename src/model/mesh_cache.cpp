@@ -0,0 +1,269 @@
+#include "model/mesh_cache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+
+namespace s21 {
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'E', 'S', 'H', '\0'};
+constexpr qint64 kHashHeadTail = 64 * 1024;  // начало и конец файла целиком
+constexpr qint64 kHashBlock = 4 * 1024;      // и равномерная выборка блоков
+constexpr int kHashBlocks = 64;
+
+// Заголовок файла-спутника; за ним секции, выровненные на 8 байт:
+// вершины, смещения граней (F + 1), индексы граней, рёбра (пары).
+struct SidecarHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  uint32_t vertex_size;
+  uint32_t reserved;
+  uint64_t source_size;
+  int64_t source_mtime_ms;
+  uint64_t source_hash;
+  uint64_t vertex_count;
+  uint64_t polygon_count;
+  uint64_t index_count;
+  uint64_t edge_index_count;
+  uint64_t num_edges;
+};
+
+inline uint64_t Align8(uint64_t v) { return (v + 7) & ~uint64_t(7); }
+
+inline void Fnv1a(uint64_t &h, const uchar *p, qint64 n) {
+  for (qint64 i = 0; i < n; ++i) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+}
+
+struct Layout {
+  uint64_t vertices, offsets, indices, edges, total;
+};
+
+Layout ComputeLayout(const SidecarHeader &h) {
+  Layout l{};
+  l.vertices = Align8(sizeof(SidecarHeader));
+  l.offsets = Align8(l.vertices + h.vertex_count * h.vertex_size);
+  l.indices = Align8(l.offsets + (h.polygon_count + 1) * sizeof(uint32_t));
+  l.edges = Align8(l.indices + h.index_count * sizeof(uint32_t));
+  l.total = l.edges + h.edge_index_count * sizeof(uint32_t);
+  return l;
+}
+
+bool Fail(std::string *err, const std::string &msg) {
+  if (err) *err = msg;
+  return false;
+}
+
+}  // namespace
+
+MeshCache::MeshCache(std::string cache_dir) : cache_dir_(std::move(cache_dir)) {}
+
+std::string MeshCache::SidecarPath(const std::string &source_path) const {
+  if (cache_dir_.empty()) return source_path + ".s21mesh";
+
+  QFileInfo fi(QString::fromStdString(source_path));
+  QString key = fi.canonicalFilePath();
+  if (key.isEmpty()) key = fi.absoluteFilePath();
+  const std::string k = key.toStdString();
+  uint64_t h = 14695981039346656037ULL;
+  Fnv1a(h, reinterpret_cast<const uchar *>(k.data()),
+        static_cast<qint64>(k.size()));
+  return QDir(QString::fromStdString(cache_dir_))
+      .filePath(QString::number(h, 16) + ".s21mesh")
+      .toStdString();
+}
+
+bool MeshCache::HashSource(const std::string &path, uint64_t &size,
+                           int64_t &mtime_ms, uint64_t &hash) {
+  QFileInfo fi(QString::fromStdString(path));
+  if (!fi.exists()) return false;
+  size = static_cast<uint64_t>(fi.size());
+  mtime_ms = fi.lastModified().toMSecsSinceEpoch();
+
+  QFile f(QString::fromStdString(path));
+  if (!f.open(QIODevice::ReadOnly)) return false;
+  const qint64 fsz = f.size();
+  hash = 14695981039346656037ULL;
+  Fnv1a(hash, reinterpret_cast<const uchar *>(&size), sizeof(size));
+  if (fsz <= 0) return true;
+
+  uchar *data = f.map(0, fsz);
+  if (!data) return false;
+  if (fsz <= 2 * kHashHeadTail + kHashBlocks * kHashBlock) {
+    Fnv1a(hash, data, fsz);
+  } else {
+    Fnv1a(hash, data, kHashHeadTail);
+    const qint64 span = fsz - 2 * kHashHeadTail - kHashBlock;
+    for (int i = 0; i < kHashBlocks; ++i)
+      Fnv1a(hash, data + kHashHeadTail + span / (kHashBlocks - 1) * i,
+            kHashBlock);
+    Fnv1a(hash, data + fsz - kHashHeadTail, kHashHeadTail);
+  }
+  f.unmap(data);
+  return true;
+}
+
+bool MeshCache::Load(const std::string &source_path, Model &out,
+                     std::string *err) const {
+  QFile f(QString::fromStdString(SidecarPath(source_path)));
+  if (!f.open(QIODevice::ReadOnly)) return Fail(err, "No mesh cache");
+  const qint64 fsz = f.size();
+  if (fsz < static_cast<qint64>(sizeof(SidecarHeader)))
+    return Fail(err, "Mesh cache is truncated");
+
+  uchar *data = f.map(0, fsz);
+  if (!data) return Fail(err, "Unable to map mesh cache");
+
+  SidecarHeader h;
+  std::memcpy(&h, data, sizeof(h));
+  const Layout l = ComputeLayout(h);
+
+  uint64_t src_size = 0, src_hash = 0;
+  int64_t src_mtime = 0;
+  const uint64_t limit = static_cast<uint64_t>(fsz);
+  bool ok = std::memcmp(h.magic, kMagic, sizeof(kMagic)) == 0 &&
+            h.version == kVersion && h.header_size == sizeof(SidecarHeader) &&
+            h.vertex_size == sizeof(Model::Vertex) &&
+            h.vertex_count <= limit && h.polygon_count <= limit &&
+            h.index_count <= limit && h.edge_index_count <= limit &&
+            l.total == limit;
+  if (!ok) {
+    f.unmap(data);
+    return Fail(err, "Mesh cache has incompatible format");
+  }
+  ok = HashSource(source_path, src_size, src_mtime, src_hash) &&
+       src_size == h.source_size && src_mtime == h.source_mtime_ms &&
+       src_hash == h.source_hash;
+  if (!ok) {
+    f.unmap(data);
+    return Fail(err, "Mesh cache is stale");
+  }
+
+  // Секции копируются одним проходом — стоимость ограничена подкачкой страниц
+  const auto *vs = reinterpret_cast<const Model::Vertex *>(data + l.vertices);
+  const auto *offs = reinterpret_cast<const uint32_t *>(data + l.offsets);
+  const auto *idx = reinterpret_cast<const uint32_t *>(data + l.indices);
+  const auto *es = reinterpret_cast<const uint32_t *>(data + l.edges);
+
+  // Индексы проверяем заодно с копированием: битый кэш не должен
+  // дать выход за массив вершин
+  bool valid = offs[0] == 0 && offs[h.polygon_count] == h.index_count;
+  for (uint64_t i = 0; valid && i < h.polygon_count; ++i)
+    valid = offs[i] <= offs[i + 1];
+  for (uint64_t i = 0; valid && i < h.index_count; ++i)
+    valid = idx[i] < h.vertex_count;
+  for (uint64_t i = 0; valid && i < h.edge_index_count; ++i)
+    valid = es[i] < h.vertex_count;
+  if (!valid) {
+    f.unmap(data);
+    return Fail(err, "Mesh cache is corrupted");
+  }
+
+  out.vertices_.assign(vs, vs + h.vertex_count);
+  if (h.polygon_count)
+    out.face_offsets_.assign(offs, offs + h.polygon_count + 1);
+  else
+    out.face_offsets_.clear();
+  out.face_indices_.assign(idx, idx + h.index_count);
+  out.num_vertices_ = static_cast<int>(h.vertex_count);
+  out.edges_.assign(es, es + h.edge_index_count);
+  out.num_edges_ = static_cast<int>(h.num_edges);
+  out.ResetTransformState();
+
+  f.unmap(data);
+  return true;
+}
+
+bool MeshCache::Store(const std::string &source_path, const Model &model,
+                      std::string *err) const {
+  SidecarHeader h{};
+  std::memcpy(h.magic, kMagic, sizeof(kMagic));
+  h.version = kVersion;
+  h.header_size = sizeof(SidecarHeader);
+  h.vertex_size = sizeof(Model::Vertex);
+  if (!HashSource(source_path, h.source_size, h.source_mtime_ms,
+                  h.source_hash))
+    return Fail(err, "Unable to read source: " + source_path);
+
+  const auto &vertices = model.GetVertices();
+  const auto &indices = model.GetFaceIndices();
+  const auto &edges = model.GetEdges();
+  const auto &offsets = model.GetFaceOffsets();
+  // Пустой список граней в файле всё равно хранит offsets[0] = 0
+  static const uint32_t kNoFaces = 0;
+  const uint32_t *offs = offsets.empty() ? &kNoFaces : offsets.data();
+
+  h.vertex_count = vertices.size();
+  h.polygon_count = offsets.empty() ? 0 : offsets.size() - 1;
+  h.index_count = indices.size();
+  h.edge_index_count = edges.size();
+  h.num_edges = static_cast<uint64_t>(model.GetNumEdges());
+  const Layout l = ComputeLayout(h);
+
+  const QString target = QString::fromStdString(SidecarPath(source_path));
+  if (!cache_dir_.empty()) QDir().mkpath(QFileInfo(target).absolutePath());
+
+  QSaveFile f(target);
+  if (!f.open(QIODevice::WriteOnly))
+    return Fail(err, "Unable to write mesh cache: " + target.toStdString());
+
+  qint64 pos = 0;
+  bool ok = true;
+  auto write = [&](const void *src, qint64 bytes) {
+    if (ok && bytes > 0)
+      ok = f.write(static_cast<const char *>(src), bytes) == bytes;
+    pos += bytes;
+  };
+  auto put = [&](uint64_t at, const void *src, uint64_t bytes) {
+    static const char kZeros[8] = {};
+    write(kZeros, static_cast<qint64>(at) - pos);  // выравнивание секции
+    write(src, static_cast<qint64>(bytes));
+  };
+  put(0, &h, sizeof(h));
+  put(l.vertices, vertices.data(), vertices.size() * sizeof(Model::Vertex));
+  put(l.offsets, offs, (h.polygon_count + 1) * sizeof(uint32_t));
+  put(l.indices, indices.data(), indices.size() * sizeof(uint32_t));
+  put(l.edges, edges.data(), edges.size() * sizeof(uint32_t));
+
+  if (!ok || pos != static_cast<qint64>(l.total) || !f.commit())
+    return Fail(err, "Unable to write mesh cache: " + target.toStdString());
+  return true;
+}
+
+CachedObjLoader::CachedObjLoader(std::string cache_dir)
+    : cache_(std::move(cache_dir)) {}
+
+void CachedObjLoader::SetLoadControl(LoadControl *control) {
+  IModelLoader::SetLoadControl(control);
+  parser_.SetLoadControl(control);
+}
+
+bool CachedObjLoader::Load(const std::string &path, Model &out,
+                           std::string *err) {
+  if (Cancelled()) return Fail(err, kCancelledError);
+  from_cache_ = cache_.Load(path, out);
+  if (from_cache_) {
+    if (control_) {
+      control_->Start(static_cast<uint64_t>(QFileInfo(
+          QString::fromStdString(path)).size()));
+      control_->Finish();
+    }
+    return true;
+  }
+
+  if (!parser_.Load(path, out, err)) return false;
+  // Кэш — только ускорение: ошибка записи не ломает загрузку
+  cache_.Store(path, out);
+  return true;
+}
+
+}  // namespace s21
@@ -0,0 +1,70 @@
+#ifndef S21_MESH_CACHE_H
+#define S21_MESH_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "model/obj_model.h"
+#include "model/obj_parser.h"
+
+namespace s21
+{
+
+    // Бинарный кэш разобранной модели (версионированный файл-спутник).
+    // Хранит вершины, плоский массив индексов граней и уникальные рёбра.
+    // Актуальность проверяется по размеру, mtime и хэшу содержимого исходника.
+    class MeshCache
+    {
+    public:
+        static constexpr uint32_t kVersion = 2;
+
+        // Пустой cache_dir — кэш кладётся рядом с исходником (<file>.s21mesh)
+        explicit MeshCache(std::string cache_dir = {});
+
+        std::string SidecarPath(const std::string &source_path) const;
+
+        bool Load(const std::string &source_path,
+                  Model &out,
+                  std::string *err = nullptr) const;
+
+        bool Store(const std::string &source_path,
+                   const Model &model,
+                   std::string *err = nullptr) const;
+
+        // Хэш содержимого по выборке блоков: O(1) чтений на любом размере
+        static bool HashSource(const std::string &path,
+                               uint64_t &size,
+                               int64_t &mtime_ms,
+                               uint64_t &hash);
+
+    private:
+        std::string cache_dir_;
+    };
+
+    // Загрузчик: сначала пробует кэш, иначе разбирает OBJ и пишет кэш
+    class CachedObjLoader : public IModelLoader
+    {
+    public:
+        explicit CachedObjLoader(std::string cache_dir = {});
+
+        ObjParser &parser() { return parser_; }
+        const MeshCache &cache() const { return cache_; }
+
+        bool Load(const std::string &path,
+                  Model &out,
+                  std::string *err = nullptr) override;
+
+        bool LastLoadFromCache() const { return from_cache_; }
+
+        void SetLoadControl(LoadControl *control) override;
+
+    private:
+        ObjParser parser_;
+        MeshCache cache_;
+        bool from_cache_ = false;
+    };
+
+} // namespace s21
+
+#endif // S21_MESH_CACHE_H
@@ -0,0 +1,90 @@
+#include "model/model_cache.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <iterator>
+#include <utility>
+
+namespace s21 {
+
+ModelCache::ModelCache(size_t budget_bytes) : budget_(budget_bytes) {}
+
+ModelCache::Key ModelCache::MakeKey(const std::string &path) {
+  Key key;
+  QFileInfo fi(QString::fromStdString(path));
+  if (!fi.exists()) return key;
+  QString canonical = fi.canonicalFilePath();
+  if (canonical.isEmpty()) canonical = fi.absoluteFilePath();
+  key.path = canonical.toStdString();
+  key.size = fi.size();
+  key.mtime_ms = fi.lastModified().toMSecsSinceEpoch();
+  return key;
+}
+
+size_t ModelCache::ModelBytes(const Model &model) {
+  return model.GetVertices().size() * sizeof(Model::Vertex) +
+         (model.GetFaceOffsets().size() + model.GetFaceIndices().size() +
+          model.GetEdges().size()) *
+             sizeof(uint32_t);
+}
+
+ModelPtr ModelCache::Find(const Key &key) {
+  auto found = key.valid() ? index_.find(key.path) : index_.end();
+  if (found == index_.end()) {
+    ++stats_.misses;
+    return nullptr;
+  }
+  const List::iterator it = found->second;
+  if (it->key.size != key.size || it->key.mtime_ms != key.mtime_ms) {
+    // Файл изменился — запись устарела
+    Erase(it);
+    ++stats_.misses;
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it);
+  ++stats_.hits;
+  return it->model;
+}
+
+void ModelCache::Insert(const Key &key, ModelPtr model) {
+  if (!key.valid() || !model) return;
+  auto found = index_.find(key.path);
+  if (found != index_.end()) Erase(found->second);
+
+  const size_t bytes = ModelBytes(*model);
+  if (bytes > budget_) return;
+
+  lru_.push_front(Entry{key, std::move(model), bytes});
+  index_[key.path] = lru_.begin();
+  stats_.bytes += bytes;
+  stats_.entries = lru_.size();
+  EvictToBudget();
+}
+
+void ModelCache::Clear() {
+  lru_.clear();
+  index_.clear();
+  stats_.bytes = 0;
+  stats_.entries = 0;
+}
+
+void ModelCache::SetBudget(size_t budget_bytes) {
+  budget_ = budget_bytes;
+  EvictToBudget();
+}
+
+void ModelCache::Erase(List::iterator it) {
+  stats_.bytes -= it->bytes;
+  index_.erase(it->key.path);
+  lru_.erase(it);
+  stats_.entries = lru_.size();
+}
+
+void ModelCache::EvictToBudget() {
+  while (stats_.bytes > budget_ && !lru_.empty()) {
+    Erase(std::prev(lru_.end()));
+    ++stats_.evictions;
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,75 @@
+#ifndef S21_MODEL_CACHE_H
+#define S21_MODEL_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "model/obj_model.h"
+
+namespace s21 {
+
+// Кэш разобранных моделей в памяти с вытеснением давно не открытых (LRU)
+// по бюджету байт. Хранит неизменяемые снимки: попадание отдаёт тот же
+// указатель без копирования вершин, граней и рёбер. В float-сборке массив
+// вершин модели и есть буфер для GPU — отдельная копия не нужна.
+// Не потокобезопасен: используется из потока UI.
+class ModelCache {
+ public:
+  // Ключ — канонический путь, размер и время изменения файла
+  struct Key {
+    std::string path;
+    int64_t size = -1;
+    int64_t mtime_ms = 0;
+    bool valid() const { return size >= 0; }
+  };
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+  };
+
+  static constexpr size_t kDefaultBudget = size_t(1) << 30;
+
+  explicit ModelCache(size_t budget_bytes = kDefaultBudget);
+
+  // Ключ по текущему состоянию файла; invalid — файла нет
+  static Key MakeKey(const std::string &path);
+  // Память модели: вершины, грани и рёбра
+  static size_t ModelBytes(const Model &model);
+
+  // nullptr — промах; запись с тем же путём, но другим файлом удаляется
+  ModelPtr Find(const Key &key);
+  // Модель больше бюджета не кэшируется
+  void Insert(const Key &key, ModelPtr model);
+  void Clear();
+
+  void SetBudget(size_t budget_bytes);
+  size_t budget() const { return budget_; }
+  const Stats &stats() const { return stats_; }
+
+ private:
+  struct Entry {
+    Key key;
+    ModelPtr model;
+    size_t bytes = 0;
+  };
+  using List = std::list<Entry>;  // начало — последние использованные
+
+  void Erase(List::iterator it);
+  void EvictToBudget();
+
+  size_t budget_;
+  List lru_;
+  std::unordered_map<std::string, List::iterator> index_;
+  Stats stats_;
+};
+
+}  // namespace s21
+
+#endif  // S21_MODEL_CACHE_H
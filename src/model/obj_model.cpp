@@ -1,84 +1,112 @@
 #include "model/obj_model.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
+#include "core/parallel.h"
+#include "model/edge_builder.h"
+#include "model/vertex_kernels.h"
+
 namespace s21
 {
 
-  void Model::BuildEdges(std::vector<uint32_t> &out_edges) const
+  namespace
   {
-    out_edges.clear();
-    for (const auto &poly : polygons_)
-    {
-      const auto &idx = poly.points_indices;
-      if (idx.size() < 2)
-        continue;
 
-      for (size_t i = 0; i < idx.size(); ++i)
-      {
-        uint32_t a = static_cast<uint32_t>(idx[i]);
-        uint32_t b = static_cast<uint32_t>(idx[(i + 1) % idx.size()]);
-        out_edges.push_back(a);
-        out_edges.push_back(b);
-      }
+    // Блок параллельного прохода: ~1.5 МБ вершин
+    constexpr size_t kBlockVertices = size_t(1) << 16;
+
+    size_t BlockCount(size_t n)
+    {
+      return (n + kBlockVertices - 1) / kBlockVertices;
     }
-  }
 
-  Model::Aabb Model::ComputeAabb() const
-  {
-    Model::Aabb box{};
-    if (vertices_.empty())
+    void Merge(Model::Aabb &box, const Model::Aabb &part)
     {
-      box.min = box.max = Vertex{0, 0, 0};
-      return box;
+      box.min.x = part.min.x < box.min.x ? part.min.x : box.min.x;
+      box.min.y = part.min.y < box.min.y ? part.min.y : box.min.y;
+      box.min.z = part.min.z < box.min.z ? part.min.z : box.min.z;
+      box.max.x = part.max.x > box.max.x ? part.max.x : box.max.x;
+      box.max.y = part.max.y > box.max.y ? part.max.y : box.max.y;
+      box.max.z = part.max.z > box.max.z ? part.max.z : box.max.z;
     }
 
-    box.min = box.max = vertices_.front();
+    // Сквозной счётчик: версии разных моделей не совпадают
+    std::atomic<uint64_t> g_version{0};
 
-    for (const auto &v : vertices_)
+    uint64_t NextVersion()
     {
-      if (v.x < box.min.x)
-        box.min.x = v.x;
-      if (v.y < box.min.y)
-        box.min.y = v.y;
-      if (v.z < box.min.z)
-        box.min.z = v.z;
-
-      if (v.x > box.max.x)
-        box.max.x = v.x;
-      if (v.y > box.max.y)
-        box.max.y = v.y;
-      if (v.z > box.max.z)
-        box.max.z = v.z;
+      return g_version.fetch_add(1, std::memory_order_relaxed) + 1;
     }
 
-    return box;
+    // x' = A x + t в double (без округления до Scalar)
+    void ApplyPoint(const Model::Affine &m, const double in[3], double out[3])
+    {
+      for (int i = 0; i < 3; ++i)
+        out[i] = m.a[3 * i] * in[0] + m.a[3 * i + 1] * in[1] +
+                 m.a[3 * i + 2] * in[2] + m.t[i];
+    }
+
+  } // namespace
+
+  void Model::BuildEdges(std::vector<uint32_t> &out_edges) const
+  {
+    out_edges = edges_;
   }
 
-  void Model::Translate(double dx, double dy, double dz)
+  void Model::RebuildEdges(unsigned threads)
   {
-    for (auto &v : vertices_)
+    EdgeBuildOptions options;
+    options.threads = threads;
+    const size_t n = ExtractUniqueEdges(face_offsets_, face_indices_,
+                                        vertices_.size(), edges_, options);
+    num_edges_ = static_cast<int>(n);
+    topology_version_ = NextVersion();
+  }
+
+  Model::Affine Model::Affine::Then(const Affine &next) const
+  {
+    Affine r;
+    for (int i = 0; i < 3; ++i)
     {
-      v.x += dx;
-      v.y += dy;
-      v.z += dz;
+      const double *n = next.a + 3 * i;
+      for (int j = 0; j < 3; ++j)
+        r.a[3 * i + j] = n[0] * a[j] + n[1] * a[3 + j] + n[2] * a[6 + j];
+      r.t[i] = n[0] * t[0] + n[1] * t[1] + n[2] * t[2] + next.t[i];
     }
+    return r;
   }
 
-  void Model::Scale(double k)
+  bool Model::Affine::IsIdentity() const
   {
-    if (vertices_.empty())
-      return;
+    const Affine e;
+    for (int i = 0; i < 9; ++i)
+      if (a[i] != e.a[i])
+        return false;
+    return t[0] == 0 && t[1] == 0 && t[2] == 0;
+  }
 
-    const auto c = ComputeAabb().center();
-    for (auto &v : vertices_)
-    {
-      v.x = (v.x - c.x) * k + c.x;
-      v.y = (v.y - c.y) * k + c.y;
-      v.z = (v.z - c.z) * k + c.z;
-    }
+  Model::Affine Model::Affine::Translation(double dx, double dy, double dz)
+  {
+    Affine m;
+    m.t[0] = dx;
+    m.t[1] = dy;
+    m.t[2] = dz;
+    return m;
+  }
+
+  Model::Affine Model::Affine::Scaling(double k, const double c[3])
+  {
+    // x' = k (x - c) + c
+    Affine m;
+    m.a[0] = m.a[4] = m.a[8] = k;
+    for (int i = 0; i < 3; ++i)
+      m.t[i] = c[i] - k * c[i];
+    return m;
   }
 
   static inline double rad(double deg)
@@ -86,70 +114,278 @@ namespace s21
     return deg * M_PI / 180.0;
   }
 
-  void Model::RotateX(double deg)
+  Model::Affine Model::Affine::Rotation(int axis, double deg, const double c[3])
   {
-    if (vertices_.empty())
-      return;
-
-    const auto c = ComputeAabb().center();
     const double s = std::sin(rad(deg));
     const double cs = std::cos(rad(deg));
 
-    for (auto &v : vertices_)
-    {
-      double y = v.y - c.y;
-      double z = v.z - c.z;
+    // Поворот в плоскости (u, w); ось axis неподвижна
+    const int u = (axis + 1) % 3;
+    const int w = (axis + 2) % 3;
+    Affine m;
+    m.a[3 * u + u] = cs;
+    m.a[3 * u + w] = -s;
+    m.a[3 * w + u] = s;
+    m.a[3 * w + w] = cs;
 
-      double y2 = y * cs - z * s;
-      double z2 = y * s + z * cs;
+    // x' = R (x - c) + c
+    for (int i = 0; i < 3; ++i)
+      m.t[i] = c[i] - (m.a[3 * i] * c[0] + m.a[3 * i + 1] * c[1] +
+                       m.a[3 * i + 2] * c[2]);
+    return m;
+  }
 
-      v.y = y2 + c.y;
-      v.z = z2 + c.z;
+  void Model::ResetTransformState()
+  {
+    pending_ = Affine{};
+    has_pending_ = false;
+    box_xform_ = Affine{};
+    box_valid_ = false;
+    topology_version_ = NextVersion();
+    geometry_version_ = NextVersion();
+    dirty_since_ = 0;
+  }
+
+  void Model::AdoptLoaded(std::vector<uint32_t> &&edges, const Aabb *box)
+  {
+    num_vertices_ = static_cast<int>(vertices_.size());
+    edges_ = std::move(edges);
+    num_edges_ = static_cast<int>(edges_.size() / 2);
+    topology_version_ = NextVersion();
+    if (box)
+    {
+      box_ = *box;
+      box_valid_ = true;
     }
   }
 
-  void Model::RotateY(double deg)
+  unsigned Model::PassThreads() const
+  {
+    if (vertices_.size() < parallel_threshold_)
+      return 1;
+    return ResolveThreadCount(threads_);
+  }
+
+  void Model::Compose(const Affine &op)
   {
     if (vertices_.empty())
       return;
+    EnsureBox();
+    pending_ = pending_.Then(op);
+    has_pending_ = true;
+    box_xform_ = box_xform_.Then(op);
+    geometry_version_ = NextVersion();
+    dirty_since_ = 0;
+  }
 
-    const auto c = ComputeAabb().center();
-    const double s = std::sin(rad(deg));
-    const double cs = std::cos(rad(deg));
+  bool Model::ChangedVertices(uint64_t from, size_t *first,
+                              size_t *count) const
+  {
+    if (from == geometry_version_)
+    {
+      *first = *count = 0;
+      return true;
+    }
+    if (dirty_since_ == 0 || from != dirty_since_)
+      return false;
+    *first = dirty_begin_;
+    *count = dirty_end_ - dirty_begin_;
+    return true;
+  }
+
+  void Model::UpdateVertices(size_t first, const Vertex *v, size_t count)
+  {
+    if (count == 0 || first >= vertices_.size())
+      return;
+    count = std::min(count, vertices_.size() - first);
+    Bake();
+    std::copy(v, v + count, vertices_.begin() + static_cast<std::ptrdiff_t>(
+                                                    first));
 
-    for (auto &v : vertices_)
+    // Правки подряд копят один диапазон от версии до первой из них
+    if (dirty_since_ == 0)
+    {
+      dirty_since_ = geometry_version_;
+      dirty_begin_ = first;
+      dirty_end_ = first + count;
+    }
+    else
     {
-      double x = v.x - c.x;
-      double z = v.z - c.z;
+      dirty_begin_ = std::min(dirty_begin_, first);
+      dirty_end_ = std::max(dirty_end_, first + count);
+    }
+    geometry_version_ = NextVersion();
 
-      double x2 = x * cs + z * s;
-      double z2 = -x * s + z * cs;
+    // Объём — заново по вершинам; прежние преобразования уже в них
+    box_xform_ = Affine{};
+    box_valid_ = false;
+  }
+
+  void Model::Bake() const
+  {
+    if (!has_pending_)
+      return;
 
-      v.x = x2 + c.x;
-      v.z = z2 + c.z;
+    Vertex *data = vertices_.data();
+    const size_t n = vertices_.size();
+    const Affine &m = pending_;
+    const unsigned threads = PassThreads();
+    if (threads <= 1)
+    {
+      TransformVertices(data, n, m);
+    }
+    else
+    {
+      ParallelFor(BlockCount(n), threads, [&](size_t b)
+                  {
+                    const size_t begin = b * kBlockVertices;
+                    TransformVertices(data + begin,
+                                      std::min(kBlockVertices, n - begin), m);
+                  });
     }
+
+    // Ограничивающий объём от запекания не зависит
+    pending_ = Affine{};
+    has_pending_ = false;
   }
 
-  void Model::RotateZ(double deg)
+  void Model::EnsureBox() const
   {
-    if (vertices_.empty())
+    if (box_valid_)
       return;
+    // Один точный проход после загрузки; дальше объём ведётся аналитически
+    // (box_xform_ здесь всегда единичное: Compose сначала вызывает EnsureBox)
+    box_ = ComputeExactAabb();
+    box_valid_ = true;
+  }
 
-    const auto c = ComputeAabb().center();
-    const double s = std::sin(rad(deg));
-    const double cs = std::cos(rad(deg));
+  void Model::Pivot(double out[3]) const
+  {
+    EnsureBox();
+    const double c[3] = {(box_.min.x + double(box_.max.x)) / 2.0,
+                         (box_.min.y + double(box_.max.y)) / 2.0,
+                         (box_.min.z + double(box_.max.z)) / 2.0};
+    ApplyPoint(box_xform_, c, out);
+  }
+
+  bool Model::IsAabbExact() const
+  {
+    // Без поворотов оси AABB остаются осями: углы дают точный ответ
+    const double *a = box_xform_.a;
+    return a[1] == 0 && a[2] == 0 && a[3] == 0 && a[5] == 0 && a[6] == 0 &&
+           a[7] == 0;
+  }
 
-    for (auto &v : vertices_)
+  Model::Aabb Model::ComputeAabb() const
+  {
+    if (vertices_.empty())
+      return ComputeExactAabb();
+    EnsureBox();
+
+    double lo[3] = {}, hi[3] = {};
+    for (int corner = 0; corner < 8; ++corner)
     {
-      double x = v.x - c.x;
-      double y = v.y - c.y;
+      const double p[3] = {corner & 1 ? box_.max.x : box_.min.x,
+                           corner & 2 ? box_.max.y : box_.min.y,
+                           corner & 4 ? box_.max.z : box_.min.z};
+      double q[3];
+      ApplyPoint(box_xform_, p, q);
+      for (int i = 0; i < 3; ++i)
+      {
+        lo[i] = corner == 0 ? q[i] : std::min(lo[i], q[i]);
+        hi[i] = corner == 0 ? q[i] : std::max(hi[i], q[i]);
+      }
+    }
 
-      double x2 = x * cs - y * s;
-      double y2 = x * s + y * cs;
+    Aabb box;
+    box.min = Vertex(static_cast<Scalar>(lo[0]), static_cast<Scalar>(lo[1]),
+                     static_cast<Scalar>(lo[2]));
+    box.max = Vertex(static_cast<Scalar>(hi[0]), static_cast<Scalar>(hi[1]),
+                     static_cast<Scalar>(hi[2]));
+    return box;
+  }
+
+  Model::Aabb Model::ComputeExactAabb() const
+  {
+    Model::Aabb box{};
+    if (vertices_.empty())
+    {
+      box.min = box.max = Vertex{0, 0, 0};
+      return box;
+    }
 
-      v.x = x2 + c.x;
-      v.y = y2 + c.y;
+    // Только чтение: преобразование применяется «на лету», без записи
+    const Vertex *data = vertices_.data();
+    const size_t n = vertices_.size();
+    const Affine *m = has_pending_ ? &pending_ : nullptr;
+    const unsigned threads = PassThreads();
+    if (threads <= 1)
+    {
+      box = ComputeBounds(data, n, m);
+    }
+    else
+    {
+      // Частичные AABB по блокам, свёртка в порядке блоков
+      std::vector<Aabb> parts(BlockCount(n));
+      ParallelFor(parts.size(), threads, [&](size_t b)
+                  {
+                    const size_t begin = b * kBlockVertices;
+                    parts[b] = ComputeBounds(
+                        data + begin, std::min(kBlockVertices, n - begin), m);
+                  });
+      box = parts.front();
+      for (size_t b = 1; b < parts.size(); ++b)
+        Merge(box, parts[b]);
     }
+    return box;
+  }
+
+  void Model::Translate(double dx, double dy, double dz)
+  {
+    Compose(Affine::Translation(dx, dy, dz));
+  }
+
+  void Model::Scale(double k)
+  {
+    if (vertices_.empty() || k == 1.0)
+      return;
+
+    double c[3];
+    Pivot(c);
+    Compose(Affine::Scaling(k, c));
+  }
+
+  void Model::RotateAroundCenter(int axis, double deg)
+  {
+    if (vertices_.empty())
+      return;
+
+    // Центр объёма при повороте вокруг него не смещается — опорная
+    // точка серии поворотов остаётся той же без пересчёта AABB
+    double c[3];
+    Pivot(c);
+    Compose(Affine::Rotation(axis, deg, c));
+  }
+
+  void Model::Transform(const Affine &m)
+  {
+    if (!m.IsIdentity())
+      Compose(m);
+  }
+
+  void Model::RotateX(double deg)
+  {
+    RotateAroundCenter(0, deg);
+  }
+
+  void Model::RotateY(double deg)
+  {
+    RotateAroundCenter(1, deg);
+  }
+
+  void Model::RotateZ(double deg)
+  {
+    RotateAroundCenter(2, deg);
   }
 
 } // namespace s21
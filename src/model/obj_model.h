@@ -3,67 +3,238 @@
 
 #include <cmath>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace s21 {
 
 class Model {
  public:
+  // Тип координат: float (по умолчанию, как на GPU) или double —
+  // опция сборки VIEWER_FLOAT_VERTICES
+#ifdef S21_FLOAT_VERTICES
+  using Scalar = float;
+#else
+  using Scalar = double;
+#endif
+
   class Vertex {
    public:
-    double x, y, z;
-    Vertex(double x = 0, double y = 0, double z = 0) : x(x), y(y), z(z) {}
+    Scalar x, y, z;
+    Vertex(Scalar x = 0, Scalar y = 0, Scalar z = 0) : x(x), y(y), z(z) {}
   };
 
+  // Грань — лёгкое представление (span) над общим массивом индексов
   class Polygon {
    public:
-    std::vector<int> points_indices;
-    Polygon(const std::vector<int> &indices = {}) : points_indices(indices) {}
-    int count_of_vertices() const {
-      return static_cast<int>(points_indices.size());
+    Polygon(const uint32_t *data = nullptr, size_t size = 0)
+        : data_(data), size_(size) {}
+    int count_of_vertices() const { return static_cast<int>(size_); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const uint32_t *data() const { return data_; }
+    const uint32_t *begin() const { return data_; }
+    const uint32_t *end() const { return data_ + size_; }
+    uint32_t operator[](size_t i) const { return data_[i]; }
+
+   private:
+    const uint32_t *data_;
+    size_t size_;
+  };
+
+  // Топология в формате CSR: offsets (F + 1 элементов) и плоские индексы;
+  // грань i — indices[offsets[i], offsets[i + 1])
+  class PolygonList {
+   public:
+    class Iterator {
+     public:
+      Iterator(const PolygonList *list, size_t i) : list_(list), i_(i) {}
+      Polygon operator*() const { return (*list_)[i_]; }
+      Iterator &operator++() {
+        ++i_;
+        return *this;
+      }
+      bool operator!=(const Iterator &o) const { return i_ != o.i_; }
+      bool operator==(const Iterator &o) const { return i_ == o.i_; }
+
+     private:
+      const PolygonList *list_;
+      size_t i_;
+    };
+
+    PolygonList(const std::vector<uint32_t> &offsets,
+                const std::vector<uint32_t> &indices)
+        : offsets_(offsets), indices_(indices) {}
+
+    size_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    bool empty() const { return size() == 0; }
+    Polygon operator[](size_t i) const {
+      return Polygon(indices_.data() + offsets_[i],
+                     offsets_[i + 1] - offsets_[i]);
+    }
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, size()); }
+
+   private:
+    const std::vector<uint32_t> &offsets_;
+    const std::vector<uint32_t> &indices_;
+  };
+
+  // Аффинное преобразование x' = A * x + t (A — 3x3, построчно)
+  struct Affine {
+    double a[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    double t[3] = {0, 0, 0};
+
+    // Считается в double, результат приводится к Scalar
+    Vertex Apply(const Vertex &v) const {
+      return Vertex(
+          static_cast<Scalar>(a[0] * v.x + a[1] * v.y + a[2] * v.z + t[0]),
+          static_cast<Scalar>(a[3] * v.x + a[4] * v.y + a[5] * v.z + t[1]),
+          static_cast<Scalar>(a[6] * v.x + a[7] * v.y + a[8] * v.z + t[2]));
     }
+    // Композиция: сначала *this, затем next
+    Affine Then(const Affine &next) const;
+    bool IsIdentity() const;
+
+    static Affine Translation(double dx, double dy, double dz);
+    // Масштаб k относительно точки c
+    static Affine Scaling(double k, const double c[3]);
+    // Поворот на deg градусов вокруг оси axis (0 — X, 1 — Y, 2 — Z),
+    // проходящей через точку c
+    static Affine Rotation(int axis, double deg, const double c[3]);
   };
 
   Model() = default;
 
-  // Доступ к данным
-  const std::vector<Vertex> &GetVertices() const { return vertices_; }
-  const std::vector<Polygon> &GetPolygons() const { return polygons_; }
+  // Доступ к данным. Вершины отдаются с применённым отложенным
+  // преобразованием (при необходимости оно «запекается» одним проходом).
+  const std::vector<Vertex> &GetVertices() const {
+    Bake();
+    return vertices_;
+  }
+  PolygonList GetPolygons() const {
+    return PolygonList(face_offsets_, face_indices_);
+  }
+  const std::vector<uint32_t> &GetFaceOffsets() const { return face_offsets_; }
+  const std::vector<uint32_t> &GetFaceIndices() const { return face_indices_; }
+  // Уникальные рёбра (пары индексов для GL_LINES), считаются при загрузке
+  const std::vector<uint32_t> &GetEdges() const { return edges_; }
   int GetNumVertices() const { return num_vertices_; }
   int GetNumEdges() const { return num_edges_; }
 
+  // Версии данных: меняются при любом изменении топологии (грани, рёбра)
+  // и геометрии (вершины, преобразования). Уникальны в пределах процесса —
+  // по ним потребители (GPU-буферы) решают, что перезагрузить.
+  uint64_t TopologyVersion() const { return topology_version_; }
+  uint64_t GeometryVersion() const { return geometry_version_; }
+  // Какие вершины изменились с версии геометрии from: [*first,
+  // *first + *count). false — неизвестно (перезагружать всё)
+  bool ChangedVertices(uint64_t from, size_t *first, size_t *count) const;
+
   // Геометрия/служебное
   void BuildEdges(std::vector<uint32_t> &out_edges) const;
+  // Пересчёт edges_/num_edges_ по текущей топологии
+  void RebuildEdges(unsigned threads = 0);
 
  public:
   struct Aabb {
     Vertex min, max;
     Vertex center() const {
-      return Vertex{(min.x + max.x) / 2.0, (min.y + max.y) / 2.0,
-                    (min.z + max.z) / 2.0};
+      return Vertex(static_cast<Scalar>((min.x + max.x) / 2.0),
+                    static_cast<Scalar>((min.y + max.y) / 2.0),
+                    static_cast<Scalar>((min.z + max.z) / 2.0));
     }
     Vertex size() const {
       return Vertex{(max.x - min.x), (max.y - min.y), (max.z - min.z)};
     }
   };
 
+  // AABB за O(1): углы AABB загруженной модели через накопленное
+  // преобразование. После сдвига/масштаба точен, после поворота —
+  // консервативен (охватывает модель, но может быть шире).
   Aabb ComputeAabb() const;
+  bool IsAabbExact() const;
+  // Точный AABB одним проходом по вершинам (без запекания)
+  Aabb ComputeExactAabb() const;
 
+  // Преобразования копятся в pending_ за O(1), вершины не трогаются.
+  // Опорная точка масштаба/поворота — центр ComputeAabb()
   void Translate(double dx, double dy, double dz);
   void Scale(double k);
   void RotateX(double deg);
   void RotateY(double deg);
   void RotateZ(double deg);
+  // Произвольное аффинное преобразование (в мировых координатах)
+  void Transform(const Affine &m);
+  // Правка на CPU: вершины [first, first + count) заменяются на v
+  // (в мировых координатах; отложенное преобразование сперва запекается).
+  // Потребители перезаливают только изменённый диапазон.
+  void UpdateVertices(size_t first, const Vertex *v, size_t count);
+
+  // Отложенное преобразование относительно хранимых вершин
+  const Affine &GetPendingTransform() const { return pending_; }
+  bool HasPendingTransform() const { return has_pending_; }
+  // Применяет отложенное преобразование к вершинам одним проходом
+  void Bake() const;
+
+  // Проходы по вершинам (AABB, запекание) делятся на блоки по потокам;
+  // модели меньше порога обрабатываются в одном потоке. Разбиение на блоки
+  // не зависит от числа потоков — результат детерминирован.
+  static constexpr size_t kParallelThreshold = size_t(1) << 18;
+  void SetThreadCount(unsigned threads) { threads_ = threads; }  // 0 — все
+  void SetParallelThreshold(size_t vertices) {
+    parallel_threshold_ = vertices;
+  }
 
  private:
-  std::vector<Vertex> vertices_;
-  std::vector<Polygon> polygons_;
+  void Compose(const Affine &op);
+  void RotateAroundCenter(int axis, double deg);
+  // Центр ограничивающего объёма в мировых координатах
+  void Pivot(double out[3]) const;
+  void EnsureBox() const;
+  // Сброс преобразования и ограничивающего объёма после замены вершин;
+  // обновляет обе версии
+  void ResetTransformState();
+  // Итог загрузки: рёбра и точный AABB (nullptr — посчитать позже),
+  // собранные загрузчиком по ходу разбора
+  void AdoptLoaded(std::vector<uint32_t> &&edges, const Aabb *box);
+  unsigned PassThreads() const;
+
+  // mutable: запекание и ленивый AABB не меняют наблюдаемую геометрию
+  mutable std::vector<Vertex> vertices_;
+  std::vector<uint32_t> face_offsets_;  // пусто или F + 1, первый = 0
+  std::vector<uint32_t> face_indices_;
+  std::vector<uint32_t> edges_;
   int num_vertices_ = 0;
   int num_edges_ = 0;
+  uint64_t topology_version_ = 0;
+  uint64_t geometry_version_ = 0;
+  // Правки UpdateVertices с версии dirty_since_ (0 — правок не было)
+  // затронули вершины [dirty_begin_, dirty_end_)
+  uint64_t dirty_since_ = 0;
+  size_t dirty_begin_ = 0;
+  size_t dirty_end_ = 0;
+
+  mutable Affine pending_;
+  mutable bool has_pending_ = false;
+
+  // Ограничивающий объём: точный AABB при загрузке (box_) и все
+  // преобразования после неё (box_xform_); не зависит от запекания
+  mutable Aabb box_{};
+  mutable bool box_valid_ = false;
+  Affine box_xform_;
+
+  unsigned threads_ = 0;
+  size_t parallel_threshold_ = kParallelThreshold;
 
   friend class ObjParser;
+  friend class MeshCache;
 };
 
+// Неизменяемый снимок модели: передаётся между потоками по указателю,
+// без копирования вершин и индексов
+using ModelPtr = std::shared_ptr<const Model>;
+
 }  // namespace s21
 
 #endif  // OBJ_MODEL_H
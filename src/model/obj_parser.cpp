@@ -2,19 +2,28 @@
 
 #include <QDebug>
 #include <QFile>
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "core/bounded_queue.h"
+#include "core/parallel.h"
+#include "model/edge_builder.h"
+#include "model/fast_number.h"
+#include "model/vertex_kernels.h"
+
 namespace s21 {
 
 // --- утилиты парсинга (переносим из старого obj_model.cpp) ---
-static inline void trim_left(const char *&p) {
-  while (*p == ' ' || *p == '\t' || *p == '\r') ++p;
+static inline void trim_left(const char *&p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
 }
 
 static inline const char *skip_token(const char *p, const char *end) {
@@ -22,51 +31,356 @@ static inline const char *skip_token(const char *p, const char *end) {
   return p;
 }
 
-static inline void parse_vertex_line_mm(const char *s,
-                                        const char * /*line_end*/,
-                                        std::vector<Model::Vertex> &out_vs) {
-  char *e = nullptr;
-  double x = strtod(s, &e);
-  s = e;
-  trim_left(s);
-  double y = strtod(s, &e);
-  s = e;
-  trim_left(s);
-  double z = strtod(s, &e);  // s = e;
-  out_vs.emplace_back(x, y, z);
+// Числа разбираем ParseDouble/ParseLong: без локали и в пределах строки
+static inline void parse_vertex_line_mm(const char *s, const char *line_end,
+                                        Model::Vertex &out_v) {
+  double xyz[3] = {0.0, 0.0, 0.0};
+  for (double &c : xyz) {
+    trim_left(s, line_end);
+    s = ParseDouble(s, line_end, c);
+  }
+  // Сразу в тип хранения модели (float по умолчанию), без промежуточных копий
+  out_v = Model::Vertex(static_cast<Model::Scalar>(xyz[0]),
+                        static_cast<Model::Scalar>(xyz[1]),
+                        static_cast<Model::Scalar>(xyz[2]));
 }
 
 static inline void parse_face_line_mm(const char *s, const char *line_end,
-                                      std::vector<int> &out_indices,
+                                      std::vector<uint32_t> &out_indices,
                                       size_t num_vertices) {
   while (s < line_end) {
-    trim_left(s);
+    trim_left(s, line_end);
     if (s >= line_end) break;
-    char *e = nullptr;
-    long a = strtol(s, &e, 10);
+    long a = 0;
+    const char *e = ParseLong(s, line_end, a);
     if (s == e) {
       s = skip_token(s, line_end);
       continue;
     }
-    while (e < line_end && *e != ' ' && *e != '\t' && *e != '\r' && *e != '\n')
-      ++e;
+    e = skip_token(e, line_end);  // хвост "/vt/vn"
 
     if (a < 0)
       a = static_cast<long>(num_vertices) + 1 + a;  // отрицательные индексы
     if (a >= 1 && a <= static_cast<long>(num_vertices))
-      out_indices.push_back(static_cast<int>(a - 1));
+      out_indices.push_back(static_cast<uint32_t>(a - 1));
 
     s = e;
   }
 }
 
+// --- разбиение на куски для параллельного разбора ---
+
+// Меньше этого кусок не делаем: накладные расходы на поток дороже разбора
+static constexpr size_t kMinChunkBytes = size_t(1) << 20;
+// Кусков больше, чем потоков, — чтобы неравномерные куски балансировались
+static constexpr size_t kChunksPerThread = 4;
+// Шаг проверки отмены и отчёта о прогрессе внутри куска
+static constexpr size_t kControlStepBytes = size_t(1) << 20;
+
+struct ParseChunk {
+  const char *begin = nullptr;
+  const char *end = nullptr;
+  size_t v_cnt = 0;   // вершин в куске (1-й проход)
+  size_t f_cnt = 0;   // граней в куске (1-й проход)
+  size_t v_base = 0;  // сколько вершин во всех предыдущих кусках
+  size_t f_base = 0;  // граней и индексов в предыдущих кусках (для слияния)
+  size_t i_base = 0;
+  std::vector<uint32_t> face_ends;  // локальный CSR: конец каждой грани
+  std::vector<uint32_t> indices;
+  std::vector<uint64_t> edge_keys;  // рёбра куска (стадия рёбер)
+  Model::Aabb box{};                // AABB вершин куска (при v_cnt > 0)
+};
+
+// Всё, что собирает конвейер разбора
+struct ParsedMesh {
+  std::vector<Model::Vertex> vertices;
+  std::vector<uint32_t> face_offsets;
+  std::vector<uint32_t> face_indices;
+  std::vector<uint32_t> edges;
+  Model::Aabb box{};
+  bool has_box = false;
+};
+
+// Режем [begin, end) на куски, выровненные по началу строки
+static std::vector<ParseChunk> split_chunks(const char *begin, const char *end,
+                                            unsigned threads) {
+  const size_t size = static_cast<size_t>(end - begin);
+  size_t n = 1;
+  if (threads > 1)
+    n = std::max<size_t>(
+        1, std::min(size / kMinChunkBytes, threads * kChunksPerThread));
+
+  std::vector<ParseChunk> chunks;
+  chunks.reserve(n);
+  const char *p = begin;
+  for (size_t i = 1; i <= n && p < end; ++i) {
+    const char *q = (i == n) ? end : begin + size / n * i;
+    if (q < p) q = p;
+    if (q < end) {
+      const char *nl = static_cast<const char *>(memchr(q, '\n', end - q));
+      q = nl ? nl + 1 : end;
+    }
+    ParseChunk c;
+    c.begin = p;
+    c.end = q;
+    chunks.push_back(std::move(c));
+    p = q;
+  }
+  return chunks;
+}
+
+// 1-й проход: считаем v/f для точных reserve и префиксных сумм
+static void count_chunk(ParseChunk &c, const LoadControl *control) {
+  size_t v_cnt = 0, f_cnt = 0;
+  const char *checkpoint = c.begin + kControlStepBytes;
+  for (const char *p = c.begin; p < c.end;) {
+    if (control && p >= checkpoint) {
+      if (control->IsCancelled()) return;
+      checkpoint = p + kControlStepBytes;
+    }
+    const char *nl = static_cast<const char *>(memchr(p, '\n', c.end - p));
+    const char *line_end = nl ? nl : c.end;
+    if (line_end - p >= 2) {
+      const char c0 = p[0], c1 = p[1];
+      if (c0 == 'v' && c1 == ' ')
+        ++v_cnt;
+      else if (c0 == 'f' && c1 == ' ')
+        ++f_cnt;
+    }
+    p = nl ? nl + 1 : c.end;
+  }
+  c.v_cnt = v_cnt;
+  c.f_cnt = f_cnt;
+}
+
+// 2-й проход: вершины пишем сразу на своё место в общем массиве,
+// индексы граней разрешаем относительно v_base + уже прочитанных вершин
+static void parse_chunk(ParseChunk &c, Model::Vertex *vertices,
+                        LoadControl *control) {
+  c.face_ends.reserve(c.f_cnt);
+  c.indices.reserve(c.f_cnt * 3);
+  size_t local_v = 0;
+  const char *reported = c.begin;
+  for (const char *p = c.begin; p < c.end;) {
+    if (control && p - reported >= static_cast<std::ptrdiff_t>(
+                                        kControlStepBytes)) {
+      if (control->IsCancelled()) return;
+      control->Advance(static_cast<uint64_t>(p - reported));
+      reported = p;
+    }
+    const char *nl = static_cast<const char *>(memchr(p, '\n', c.end - p));
+    const char *line_end = nl ? nl : c.end;
+
+    if (line_end - p >= 2) {
+      if (p[0] == 'v' && p[1] == ' ') {
+        parse_vertex_line_mm(p + 2, line_end, vertices[c.v_base + local_v]);
+        ++local_v;
+      } else if (p[0] == 'f' && p[1] == ' ') {
+        const size_t before = c.indices.size();
+        parse_face_line_mm(p + 2, line_end, c.indices, c.v_base + local_v);
+        if (c.indices.size() != before)
+          c.face_ends.push_back(static_cast<uint32_t>(c.indices.size()));
+      }
+    }
+    p = nl ? nl + 1 : c.end;
+  }
+  if (control) control->Advance(static_cast<uint64_t>(c.end - reported));
+}
+
+// Стадия рёбер: ключи рёбер и AABB куска, пока его данные ещё в кэше
+static void finish_chunk(ParseChunk &c, const Model::Vertex *vertices,
+                         size_t num_vertices) {
+  if (c.v_cnt) c.box = ComputeBounds(vertices + c.v_base, c.v_cnt);
+  AppendChunkEdgeKeys(c.face_ends.data(), c.face_ends.size(),
+                      c.indices.data(), num_vertices, c.edge_keys);
+}
+
+// Показ по ходу загрузки: вершины куска — сразу после разбора
+static void deliver_vertices(const ParseChunk &c, size_t index, size_t chunks,
+                             size_t num_vertices,
+                             const Model::Vertex *vertices,
+                             LoadControl *control) {
+  if (!control || !control->WantsChunks() || control->IsCancelled()) return;
+  auto part = std::make_shared<LoadedChunk>();
+  part->kind = LoadedChunk::Kind::kVertices;
+  part->index = index;
+  part->chunks = chunks;
+  part->total_vertices = num_vertices;
+  part->first_vertex = c.v_base;
+  part->positions.resize(c.v_cnt * 3);
+  const Model::Vertex *v = vertices + c.v_base;
+  for (size_t k = 0; k < c.v_cnt; ++k) {
+    part->positions[3 * k] = static_cast<float>(v[k].x);
+    part->positions[3 * k + 1] = static_cast<float>(v[k].y);
+    part->positions[3 * k + 2] = static_cast<float>(v[k].z);
+  }
+  control->Deliver(std::move(part));
+}
+
+// ... и его рёбра — после стадии рёбер
+static void deliver_edges(const ParseChunk &c, size_t index, size_t chunks,
+                          size_t num_vertices, LoadControl *control) {
+  if (!control || !control->WantsChunks() || control->IsCancelled()) return;
+  auto part = std::make_shared<LoadedChunk>();
+  part->kind = LoadedChunk::Kind::kEdges;
+  part->index = index;
+  part->chunks = chunks;
+  part->total_vertices = num_vertices;
+  EdgeKeysToPairs(c.edge_keys, num_vertices, part->edges);
+  control->Deliver(std::move(part));
+}
+
+// a и b одновременно: b — в этом потоке, a — задачей пула
+template <class A, class B>
+static void run_both(unsigned threads, A &&a, B &&b) {
+  if (threads <= 1) {
+    a();
+    b();
+    return;
+  }
+  TaskGroup group;
+  JobScheduler::Global().Submit([&a] { a(); },
+                                JobScheduler::CurrentPriority(), &group);
+  b();
+  group.Wait();
+}
+
+// Разбор конвейером: подсчёт -> разбор куска -> (очередь) -> рёбра и AABB
+// куска -> слияние CSR || уникальность рёбер. Рёбра готовых кусков
+// считаются, пока остальные ещё разбираются, поэтому отдельного прохода
+// по всей топологии после разбора нет.
+// false — загрузка отменена (результат неполный)
+static bool parse_buffer(const char *begin, const char *end, unsigned threads,
+                         ParsedMesh &out, LoadControl *control) {
+  std::vector<ParseChunk> chunks = split_chunks(begin, end, threads);
+  auto cancelled = [control] { return control && control->IsCancelled(); };
+
+  ParallelFor(chunks.size(), threads,
+              [&](size_t i) { count_chunk(chunks[i], control); });
+  if (cancelled()) return false;
+
+  // Префиксные суммы по числу вершин: база для разрешения индексов граней
+  size_t v_total = 0;
+  for (auto &c : chunks) {
+    c.v_base = v_total;
+    v_total += c.v_cnt;
+  }
+  out.vertices.resize(v_total);
+
+  Model::Vertex *vs = out.vertices.data();
+  const size_t n = chunks.size();
+  auto parse_stage = [&](size_t i) {
+    parse_chunk(chunks[i], vs, control);
+    deliver_vertices(chunks[i], i, n, v_total, vs, control);
+  };
+  auto edge_stage = [&](size_t i) {
+    if (cancelled()) return;
+    finish_chunk(chunks[i], vs, v_total);
+    deliver_edges(chunks[i], i, n, v_total, control);
+  };
+  if (threads <= 1 || n == 1) {
+    for (size_t i = 0; i < n; ++i) {
+      parse_stage(i);
+      edge_stage(i);
+    }
+  } else {
+    // Разобранные куски идут в ограниченную очередь; её разбирает одна
+    // задача пула, запускаемая по требованию. Очередь полна — стадия рёбер
+    // отстаёт, и кусок доделывает разбиравший его поток.
+    BoundedQueue<uint32_t> ready(size_t(threads) * 2);
+    std::atomic<bool> draining{false};
+    auto drain = [&] {
+      uint32_t j = 0;
+      do {
+        while (ready.TryPop(j)) edge_stage(j);
+        draining.store(false);
+      } while (!ready.Empty() && !draining.exchange(true));
+    };
+    TaskGroup stage;
+    ParallelFor(n, threads, [&](size_t i) {
+      parse_stage(i);
+      if (!ready.TryPush(static_cast<uint32_t>(i))) {
+        edge_stage(i);
+      } else if (!draining.exchange(true)) {
+        JobScheduler::Global().Submit([&drain] { drain(); },
+                                      JobScheduler::CurrentPriority(),
+                                      &stage);
+      }
+    });
+    // Хвост очереди разбирает и этот поток
+    uint32_t j = 0;
+    while (ready.TryPop(j)) edge_stage(j);
+    stage.Wait();
+  }
+  if (cancelled()) return false;
+
+  size_t f_total = 0, i_total = 0;
+  std::vector<std::vector<uint64_t>> keys(chunks.size());
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    ParseChunk &c = chunks[i];
+    c.f_base = f_total;
+    c.i_base = i_total;
+    f_total += c.face_ends.size();
+    i_total += c.indices.size();
+    keys[i].swap(c.edge_keys);
+    if (!c.v_cnt) continue;
+    if (!out.has_box) {
+      out.box = c.box;
+      out.has_box = true;
+      continue;
+    }
+    Model::Aabb &b = out.box;
+    b.min = Model::Vertex(std::min(b.min.x, c.box.min.x),
+                          std::min(b.min.y, c.box.min.y),
+                          std::min(b.min.z, c.box.min.z));
+    b.max = Model::Vertex(std::max(b.max.x, c.box.max.x),
+                          std::max(b.max.y, c.box.max.y),
+                          std::max(b.max.z, c.box.max.z));
+  }
+
+  // Слияние локальных CSR (префиксные суммы и параллельное копирование)
+  // не зависит от уникальности рёбер — стадии идут одновременно
+  auto merge_csr = [&] {
+    out.face_offsets.assign(f_total ? f_total + 1 : 0, 0);
+    out.face_indices.resize(i_total);
+    ParallelFor(chunks.size(), threads, [&](size_t i) {
+      ParseChunk &c = chunks[i];
+      const uint32_t base = static_cast<uint32_t>(c.i_base);
+      for (size_t k = 0; k < c.face_ends.size(); ++k)
+        out.face_offsets[c.f_base + k + 1] = base + c.face_ends[k];
+      std::copy(c.indices.begin(), c.indices.end(),
+                out.face_indices.begin() +
+                    static_cast<std::ptrdiff_t>(c.i_base));
+      std::vector<uint32_t>().swap(c.face_ends);
+      std::vector<uint32_t>().swap(c.indices);
+    });
+  };
+  auto unique_edges = [&] {
+    EdgeBuildOptions options;
+    options.threads = threads;
+    UniqueEdgesFromKeys(keys, v_total, out.edges, options);
+    std::vector<std::vector<uint64_t>>().swap(keys);
+  };
+  run_both(threads, merge_csr, unique_edges);
+  return true;
+}
+
 bool ObjParser::Load(const std::string &filename, s21::Model &out,
                      std::string *err) {
   // Сбрасываем объект (на всякий)
   out.vertices_.clear();
-  out.polygons_.clear();
+  out.face_offsets_.clear();
+  out.face_indices_.clear();
+  out.edges_.clear();
   out.num_vertices_ = 0;
   out.num_edges_ = 0;
+  out.ResetTransformState();
+
+  const unsigned threads = ResolveThreadCount(threads_);
+  if (Cancelled()) {
+    if (err) *err = kCancelledError;
+    return false;
+  }
 
   QFile qf(QString::fromStdString(filename));
   if (!qf.open(QIODevice::ReadOnly)) {
@@ -74,102 +388,59 @@ bool ObjParser::Load(const std::string &filename, s21::Model &out,
     return false;
   }
   const qint64 fsz = qf.size();
+  if (control_) control_->Start(fsz > 0 ? static_cast<uint64_t>(fsz) : 0);
   if (fsz <= 0) {
     // пустой файл — считаем успешной загрузкой пустой модели
     qf.close();
     return true;
   }
 
+  ParsedMesh mesh;
+  bool parsed = false;
   uchar *data = qf.map(0, fsz);  // memory-mapped файл
-  if (!data) {
-    // fallback: обычное чтение
+  if (data) {
+    const char *begin = reinterpret_cast<const char *>(data);
+    parsed = parse_buffer(begin, begin + fsz, threads, mesh, control_);
+    qf.unmap(data);
+    qf.close();
+  } else {
+    // fallback: читаем файл целиком и разбираем тем же путём
+    qf.close();
     std::ifstream in(filename, std::ios::in | std::ios::binary);
     if (!in.is_open()) {
       if (err) *err = "Unable to open file (fallback): " + filename;
       return false;
     }
-
-    // Грубые резервирования
-    in.seekg(0, std::ios::end);
-    const std::streamoff size = in.tellg();
-    in.seekg(0, std::ios::beg);
-    const size_t approx_vertices =
-        (size > 0) ? static_cast<size_t>(size) / 40 : 0;
-    out.vertices_.reserve(approx_vertices);
-    out.polygons_.reserve(approx_vertices / 2);
-
-    std::string line;
-    while (std::getline(in, line)) {
-      if (line.empty() || line[0] == '#') continue;
-      if (line.size() >= 2 && line[0] == 'v' && line[1] == ' ') {
-        const char *s = line.c_str() + 2;
-        parse_vertex_line_mm(s, s + line.size(), out.vertices_);
-      } else if (line.size() >= 2 && line[0] == 'f' && line[1] == ' ') {
-        const char *s = line.c_str() + 2;
-        Model::Polygon poly;
-        poly.points_indices.reserve(8);
-        parse_face_line_mm(s, s + line.size(), poly.points_indices,
-                           out.vertices_.size());
-        if (!poly.points_indices.empty())
-          out.polygons_.push_back(std::move(poly));
-      }
-    }
-    out.num_vertices_ = static_cast<int>(out.vertices_.size());
-    std::vector<uint32_t> tmp_edges;
-    out.BuildEdges(tmp_edges);
-    out.num_edges_ = static_cast<int>(tmp_edges.size() / 2);
-    return true;
-  }
-
-  const char *begin = reinterpret_cast<const char *>(data);
-  const char *end = begin + fsz;
-
-  // 1-й проход: точные reserve
-  size_t v_cnt = 0, f_cnt = 0;
-  for (const char *p = begin; p < end;) {
-    const char *nl = static_cast<const char *>(memchr(p, '\n', end - p));
-    const char *line_end = nl ? nl : end;
-    if (line_end - p >= 2) {
-      const char c0 = p[0], c1 = p[1];
-      if (c0 == 'v' && c1 == ' ')
-        ++v_cnt;
-      else if (c0 == 'f' && c1 == ' ')
-        ++f_cnt;
-    }
-    p = nl ? nl + 1 : end;
+    std::string buf(static_cast<size_t>(fsz), '\0');
+    in.read(&buf[0], fsz);
+    buf.resize(static_cast<size_t>(in.gcount()));
+    parsed = parse_buffer(buf.data(), buf.data() + buf.size(), threads, mesh,
+                          control_);
   }
-  out.vertices_.reserve(v_cnt);
-  out.polygons_.reserve(f_cnt);
-
-  // 2-й проход: парсим
-  for (const char *p = begin; p < end;) {
-    const char *nl = static_cast<const char *>(memchr(p, '\n', end - p));
-    const char *line_end = nl ? nl : end;
 
-    if (line_end - p >= 2) {
-      if (p[0] == 'v' && p[1] == ' ') {
-        parse_vertex_line_mm(p + 2, line_end, out.vertices_);
-      } else if (p[0] == 'f' && p[1] == ' ') {
-        Model::Polygon poly;
-        poly.points_indices.reserve(8);
-        parse_face_line_mm(p + 2, line_end, poly.points_indices,
-                           out.vertices_.size());
-        if (!poly.points_indices.empty())
-          out.polygons_.push_back(std::move(poly));
-      }
-    }
-    p = nl ? nl + 1 : end;
+  // Память неполной модели освобождается вместе с mesh
+  if (!parsed || Cancelled()) {
+    if (err) *err = kCancelledError;
+    return false;
   }
 
-  qf.unmap(data);
-  qf.close();
-
-  out.num_vertices_ = static_cast<int>(out.vertices_.size());
-  std::vector<uint32_t> tmp_edges;
-  out.BuildEdges(tmp_edges);
-  out.num_edges_ = static_cast<int>(tmp_edges.size() / 2);
+  out.vertices_ = std::move(mesh.vertices);
+  out.face_offsets_ = std::move(mesh.face_offsets);
+  out.face_indices_ = std::move(mesh.face_indices);
+  out.AdoptLoaded(std::move(mesh.edges), mesh.has_box ? &mesh.box : nullptr);
+  if (control_) control_->Finish();
 
   return true;
 }
 
+ModelPtr LoadSnapshot(IModelLoader &loader, const std::string &path,
+                      std::string *err) {
+  // Модель сразу строится в куче: дальше по потокам ходит только указатель
+  auto model = std::make_shared<Model>();
+  if (!loader.Load(path, *model, err)) return nullptr;
+  // ObjParser считает AABB по ходу разбора; для прочих загрузчиков — здесь
+  model->ComputeAabb();
+  return model;
+}
+
 }  // namespace s21
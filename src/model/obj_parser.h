@@ -1,8 +1,10 @@
 #ifndef S21_OBJ_PARSER_H
 #define S21_OBJ_PARSER_H
 
+#include <memory>
 #include <string>
 
+#include "model/load_control.h"
 #include "model/obj_model.h"
 
 namespace s21
@@ -16,16 +18,44 @@ namespace s21
         virtual bool Load(const std::string &path,
                           Model &out,
                           std::string *err = nullptr) = 0;
+
+        // Отмена и прогресс следующих загрузок (nullptr — без них).
+        // Отменённая загрузка возвращает false с ошибкой kCancelledError.
+        virtual void SetLoadControl(LoadControl *control)
+        {
+            control_ = control;
+        }
+
+        static constexpr const char *kCancelledError = "Load cancelled";
+
+    protected:
+        bool Cancelled() const { return control_ && control_->IsCancelled(); }
+
+        LoadControl *control_ = nullptr;
     };
 
     class ObjParser : public IModelLoader
     {
     public:
+        // Число потоков разбора: 0 — по числу ядер, 1 — однопоточный режим.
+        void SetThreadCount(unsigned threads) { threads_ = threads; }
+        unsigned ThreadCount() const { return threads_; }
+
         bool Load(const std::string &path,
                   Model &out,
                   std::string *err = nullptr) override;
+
+    private:
+        unsigned threads_ = 0;
     };
 
+    // Загрузка в неизменяемый снимок (nullptr при ошибке). Снимок сразу
+    // готов к чтению из любого потока: AABB посчитан, отложенного
+    // преобразования нет, поэтому const-доступ ничего в модели не пишет.
+    ModelPtr LoadSnapshot(IModelLoader &loader,
+                          const std::string &path,
+                          std::string *err = nullptr);
+
 } // namespace s21
 
 #endif // S21_OBJ_PARSER_H
@@ -0,0 +1,55 @@
+#include "model/transform_state.h"
+
+namespace s21 {
+
+void TransformState::Reset(const Model::Aabb &bounds) {
+  affine_ = Model::Affine{};
+  pivot_[0] = (bounds.min.x + double(bounds.max.x)) / 2.0;
+  pivot_[1] = (bounds.min.y + double(bounds.max.y)) / 2.0;
+  pivot_[2] = (bounds.min.z + double(bounds.max.z)) / 2.0;
+}
+
+void TransformState::MarkBaked() {
+  double c[3];
+  Pivot(c);
+  for (int i = 0; i < 3; ++i) pivot_[i] = c[i];
+  affine_ = Model::Affine{};
+}
+
+void TransformState::Translate(double dx, double dy, double dz) {
+  affine_ = affine_.Then(Model::Affine::Translation(dx, dy, dz));
+}
+
+void TransformState::Scale(double k) {
+  if (k == 1.0) return;
+  double c[3];
+  Pivot(c);
+  affine_ = affine_.Then(Model::Affine::Scaling(k, c));
+}
+
+void TransformState::Rotate(int axis, double deg) {
+  // Поворот вокруг центра центр не сдвигает — серия поворотов идёт
+  // вокруг одной точки, полный оборот возвращает модель на место
+  double c[3];
+  Pivot(c);
+  affine_ = affine_.Then(Model::Affine::Rotation(axis, deg, c));
+}
+
+void TransformState::Pivot(double out[3]) const {
+  const double *a = affine_.a;
+  for (int i = 0; i < 3; ++i)
+    out[i] = a[3 * i] * pivot_[0] + a[3 * i + 1] * pivot_[1] +
+             a[3 * i + 2] * pivot_[2] + affine_.t[i];
+}
+
+void TransformState::ToRowMajor(float out[16]) const {
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j)
+      out[4 * i + j] = static_cast<float>(affine_.a[3 * i + j]);
+    out[4 * i + 3] = static_cast<float>(affine_.t[i]);
+  }
+  out[12] = out[13] = out[14] = 0.0F;
+  out[15] = 1.0F;
+}
+
+}  // namespace s21
@@ -0,0 +1,38 @@
+#ifndef S21_TRANSFORM_STATE_H
+#define S21_TRANSFORM_STATE_H
+
+#include "model/obj_model.h"
+
+namespace s21 {
+
+// Интерактивное преобразование модели (мышь, кнопки, запись GIF).
+// Хранится отдельно от вершин и уходит в шейдер как модельная матрица MVP:
+// каждое действие — O(1), вершины и GPU-буферы не меняются. В вершины
+// преобразование попадает только по явному запросу (Model::Transform).
+class TransformState {
+ public:
+  // Единичное преобразование; опорная точка — центр bounds
+  void Reset(const Model::Aabb &bounds);
+  // Преобразование перенесено в вершины: матрица снова единичная,
+  // опорная точка остаётся на месте в мировых координатах
+  void MarkBaked();
+
+  void Translate(double dx, double dy, double dz);
+  void Scale(double k);
+  void Rotate(int axis, double deg);  // 0 — X, 1 — Y, 2 — Z
+
+  const Model::Affine &affine() const { return affine_; }
+  bool IsIdentity() const { return affine_.IsIdentity(); }
+  // Центр модели в мировых координатах: вокруг него масштаб и поворот
+  void Pivot(double out[3]) const;
+  // Матрица 4x4 построчно (порядок конструктора QMatrix4x4(const float *))
+  void ToRowMajor(float out[16]) const;
+
+ private:
+  Model::Affine affine_;
+  double pivot_[3] = {0, 0, 0};  // в координатах вершин
+};
+
+}  // namespace s21
+
+#endif  // S21_TRANSFORM_STATE_H
@@ -0,0 +1,710 @@
+#include "model/vertex_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define S21_VERTEX_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define S21_TARGET_AVX2
+#else
+#define S21_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace s21 {
+
+namespace {
+
+using Scalar = Model::Scalar;
+
+static_assert(sizeof(Model::Vertex) == 3 * sizeof(Scalar),
+              "Model::Vertex must be a packed xyz triple");
+
+inline const Scalar *Raw(const Model::Vertex *v) {
+  return reinterpret_cast<const Scalar *>(v);
+}
+inline Scalar *Raw(Model::Vertex *v) { return reinterpret_cast<Scalar *>(v); }
+
+inline void Accumulate(const Model::Vertex &v, Model::Aabb &b) {
+  b.min.x = v.x < b.min.x ? v.x : b.min.x;
+  b.min.y = v.y < b.min.y ? v.y : b.min.y;
+  b.min.z = v.z < b.min.z ? v.z : b.min.z;
+  b.max.x = v.x > b.max.x ? v.x : b.max.x;
+  b.max.y = v.y > b.max.y ? v.y : b.max.y;
+  b.max.z = v.z > b.max.z ? v.z : b.max.z;
+}
+
+// Скалярный хвост [from, n) поверх уже накопленного b
+void BoundsTail(const Model::Vertex *v, size_t from, size_t n,
+                const Model::Affine *m, Model::Aabb &b) {
+  if (m) {
+    for (size_t i = from; i < n; ++i) Accumulate(m->Apply(v[i]), b);
+  } else {
+    for (size_t i = from; i < n; ++i) Accumulate(v[i], b);
+  }
+}
+
+Model::Aabb Seed(const Model::Vertex *v, const Model::Affine *m) {
+  Model::Aabb b;
+  b.min = b.max = m ? m->Apply(v[0]) : v[0];
+  return b;
+}
+
+void TransformTail(Model::Vertex *v, size_t from, size_t n,
+                   const Model::Affine &m) {
+  for (size_t i = from; i < n; ++i) v[i] = m.Apply(v[i]);
+}
+
+#ifdef S21_VERTEX_KERNELS_X86
+
+// min/max как в скалярном коде: minpd(v, acc) == (v < acc) ? v : acc
+inline void Fold(Scalar &lo, Scalar &hi, Scalar vlo, Scalar vhi) {
+  lo = vlo < lo ? vlo : lo;
+  hi = vhi > hi ? vhi : hi;
+}
+
+#ifndef S21_FLOAT_VERTICES
+
+// ---------------------------------------------------------------- SSE2 ---
+// 2 вершины = 6 double = 3 регистра: (x0 y0) (z0 x1) (y1 z1)
+
+inline void Load2(const double *p, __m128d &x, __m128d &y, __m128d &z) {
+  const __m128d xy0 = _mm_loadu_pd(p);
+  const __m128d xy1 = _mm_loadu_pd(p + 3);
+  x = _mm_unpacklo_pd(xy0, xy1);
+  y = _mm_unpackhi_pd(xy0, xy1);
+  z = _mm_loadh_pd(_mm_load_sd(p + 2), p + 5);
+}
+
+inline void Store2(double *p, __m128d x, __m128d y, __m128d z) {
+  _mm_storeu_pd(p, _mm_unpacklo_pd(x, y));
+  _mm_storeu_pd(p + 3, _mm_unpackhi_pd(x, y));
+  _mm_store_sd(p + 2, z);
+  _mm_storeh_pd(p + 5, z);
+}
+
+struct AffineSse2 {
+  __m128d a[9], t[3];
+  explicit AffineSse2(const Model::Affine &m) {
+    for (int i = 0; i < 9; ++i) a[i] = _mm_set1_pd(m.a[i]);
+    for (int i = 0; i < 3; ++i) t[i] = _mm_set1_pd(m.t[i]);
+  }
+  // Порядок операций как в Model::Affine::Apply
+  void Apply(__m128d &x, __m128d &y, __m128d &z) const {
+    const __m128d nx = _mm_add_pd(
+        _mm_add_pd(_mm_add_pd(_mm_mul_pd(a[0], x), _mm_mul_pd(a[1], y)),
+                   _mm_mul_pd(a[2], z)),
+        t[0]);
+    const __m128d ny = _mm_add_pd(
+        _mm_add_pd(_mm_add_pd(_mm_mul_pd(a[3], x), _mm_mul_pd(a[4], y)),
+                   _mm_mul_pd(a[5], z)),
+        t[1]);
+    const __m128d nz = _mm_add_pd(
+        _mm_add_pd(_mm_add_pd(_mm_mul_pd(a[6], x), _mm_mul_pd(a[7], y)),
+                   _mm_mul_pd(a[8], z)),
+        t[2]);
+    x = nx;
+    y = ny;
+    z = nz;
+  }
+};
+
+Model::Aabb BoundsSse2(const Model::Vertex *v, size_t n,
+                       const Model::Affine *m) {
+  Model::Aabb b = Seed(v, m);
+  const size_t body = n & ~size_t(1);
+  const double *p = Raw(v);
+  double lo[6], hi[6];
+
+  if (!m) {
+    // Без преобразования — без перестановок: у каждого регистра
+    // фиксированный шаблон компонент (x y) (z x) (y z)
+    __m128d mn0 = _mm_setr_pd(b.min.x, b.min.y), mx0 = mn0;
+    __m128d mn1 = _mm_setr_pd(b.min.z, b.min.x), mx1 = mn1;
+    __m128d mn2 = _mm_setr_pd(b.min.y, b.min.z), mx2 = mn2;
+    for (size_t i = 0; i < body; i += 2, p += 6) {
+      const __m128d r0 = _mm_loadu_pd(p);
+      const __m128d r1 = _mm_loadu_pd(p + 2);
+      const __m128d r2 = _mm_loadu_pd(p + 4);
+      mn0 = _mm_min_pd(r0, mn0);
+      mx0 = _mm_max_pd(r0, mx0);
+      mn1 = _mm_min_pd(r1, mn1);
+      mx1 = _mm_max_pd(r1, mx1);
+      mn2 = _mm_min_pd(r2, mn2);
+      mx2 = _mm_max_pd(r2, mx2);
+    }
+    _mm_storeu_pd(lo, mn0);
+    _mm_storeu_pd(lo + 2, mn1);
+    _mm_storeu_pd(lo + 4, mn2);
+    _mm_storeu_pd(hi, mx0);
+    _mm_storeu_pd(hi + 2, mx1);
+    _mm_storeu_pd(hi + 4, mx2);
+    // x: lo[0], lo[3]; y: lo[1], lo[4]; z: lo[2], lo[5]
+    for (int k = 0; k < 2; ++k) {
+      Fold(b.min.x, b.max.x, lo[3 * k], hi[3 * k]);
+      Fold(b.min.y, b.max.y, lo[3 * k + 1], hi[3 * k + 1]);
+      Fold(b.min.z, b.max.z, lo[3 * k + 2], hi[3 * k + 2]);
+    }
+  } else {
+    const AffineSse2 am(*m);
+    __m128d mnx = _mm_set1_pd(b.min.x), mxx = mnx;
+    __m128d mny = _mm_set1_pd(b.min.y), mxy = mny;
+    __m128d mnz = _mm_set1_pd(b.min.z), mxz = mnz;
+    for (size_t i = 0; i < body; i += 2, p += 6) {
+      __m128d x, y, z;
+      Load2(p, x, y, z);
+      am.Apply(x, y, z);
+      mnx = _mm_min_pd(x, mnx);
+      mxx = _mm_max_pd(x, mxx);
+      mny = _mm_min_pd(y, mny);
+      mxy = _mm_max_pd(y, mxy);
+      mnz = _mm_min_pd(z, mnz);
+      mxz = _mm_max_pd(z, mxz);
+    }
+    _mm_storeu_pd(lo, mnx);
+    _mm_storeu_pd(lo + 2, mny);
+    _mm_storeu_pd(lo + 4, mnz);
+    _mm_storeu_pd(hi, mxx);
+    _mm_storeu_pd(hi + 2, mxy);
+    _mm_storeu_pd(hi + 4, mxz);
+    for (int k = 0; k < 2; ++k) {
+      Fold(b.min.x, b.max.x, lo[k], hi[k]);
+      Fold(b.min.y, b.max.y, lo[2 + k], hi[2 + k]);
+      Fold(b.min.z, b.max.z, lo[4 + k], hi[4 + k]);
+    }
+  }
+  BoundsTail(v, body, n, m, b);
+  return b;
+}
+
+void TransformSse2(Model::Vertex *v, size_t n, const Model::Affine &m) {
+  const AffineSse2 am(m);
+  const size_t body = n & ~size_t(1);
+  double *p = Raw(v);
+  for (size_t i = 0; i < body; i += 2, p += 6) {
+    __m128d x, y, z;
+    Load2(p, x, y, z);
+    am.Apply(x, y, z);
+    Store2(p, x, y, z);
+  }
+  TransformTail(v, body, n, m);
+}
+
+// ---------------------------------------------------------------- AVX2 ---
+// 4 вершины = 12 double = 3 регистра: (x0 y0 z0 x1) (y1 z1 x2 y2)
+// (z2 x3 y3 z3); для преобразования — SoA (x0 x1 x2 x3) и т.д.
+
+S21_TARGET_AVX2 inline void Load4(const double *p, __m256d &x, __m256d &y,
+                                  __m256d &z) {
+  const __m256d xy02 = _mm256_insertf128_pd(
+      _mm256_castpd128_pd256(_mm_loadu_pd(p)), _mm_loadu_pd(p + 6), 1);
+  const __m256d xy13 = _mm256_insertf128_pd(
+      _mm256_castpd128_pd256(_mm_loadu_pd(p + 3)), _mm_loadu_pd(p + 9), 1);
+  x = _mm256_unpacklo_pd(xy02, xy13);
+  y = _mm256_unpackhi_pd(xy02, xy13);
+  const __m128d z01 = _mm_loadh_pd(_mm_load_sd(p + 2), p + 5);
+  const __m128d z23 = _mm_loadh_pd(_mm_load_sd(p + 8), p + 11);
+  z = _mm256_insertf128_pd(_mm256_castpd128_pd256(z01), z23, 1);
+}
+
+S21_TARGET_AVX2 inline void Store4(double *p, __m256d x, __m256d y,
+                                   __m256d z) {
+  const __m256d xy02 = _mm256_unpacklo_pd(x, y);
+  const __m256d xy13 = _mm256_unpackhi_pd(x, y);
+  _mm_storeu_pd(p, _mm256_castpd256_pd128(xy02));
+  _mm_storeu_pd(p + 3, _mm256_castpd256_pd128(xy13));
+  _mm_storeu_pd(p + 6, _mm256_extractf128_pd(xy02, 1));
+  _mm_storeu_pd(p + 9, _mm256_extractf128_pd(xy13, 1));
+  const __m128d z01 = _mm256_castpd256_pd128(z);
+  const __m128d z23 = _mm256_extractf128_pd(z, 1);
+  _mm_store_sd(p + 2, z01);
+  _mm_storeh_pd(p + 5, z01);
+  _mm_store_sd(p + 8, z23);
+  _mm_storeh_pd(p + 11, z23);
+}
+
+struct AffineAvx2 {
+  __m256d a[9], t[3];
+  S21_TARGET_AVX2 explicit AffineAvx2(const Model::Affine &m) {
+    for (int i = 0; i < 9; ++i) a[i] = _mm256_set1_pd(m.a[i]);
+    for (int i = 0; i < 3; ++i) t[i] = _mm256_set1_pd(m.t[i]);
+  }
+  S21_TARGET_AVX2 void Apply(__m256d &x, __m256d &y, __m256d &z) const {
+    const __m256d nx = _mm256_add_pd(
+        _mm256_add_pd(
+            _mm256_add_pd(_mm256_mul_pd(a[0], x), _mm256_mul_pd(a[1], y)),
+            _mm256_mul_pd(a[2], z)),
+        t[0]);
+    const __m256d ny = _mm256_add_pd(
+        _mm256_add_pd(
+            _mm256_add_pd(_mm256_mul_pd(a[3], x), _mm256_mul_pd(a[4], y)),
+            _mm256_mul_pd(a[5], z)),
+        t[1]);
+    const __m256d nz = _mm256_add_pd(
+        _mm256_add_pd(
+            _mm256_add_pd(_mm256_mul_pd(a[6], x), _mm256_mul_pd(a[7], y)),
+            _mm256_mul_pd(a[8], z)),
+        t[2]);
+    x = nx;
+    y = ny;
+    z = nz;
+  }
+};
+
+S21_TARGET_AVX2 Model::Aabb BoundsAvx2(const Model::Vertex *v, size_t n,
+                                       const Model::Affine *m) {
+  Model::Aabb b = Seed(v, m);
+  const size_t body = n & ~size_t(3);
+  const double *p = Raw(v);
+  double lo[12], hi[12];
+
+  if (!m) {
+    const double sx = b.min.x, sy = b.min.y, sz = b.min.z;
+    __m256d mn0 = _mm256_setr_pd(sx, sy, sz, sx), mx0 = mn0;
+    __m256d mn1 = _mm256_setr_pd(sy, sz, sx, sy), mx1 = mn1;
+    __m256d mn2 = _mm256_setr_pd(sz, sx, sy, sz), mx2 = mn2;
+    for (size_t i = 0; i < body; i += 4, p += 12) {
+      const __m256d r0 = _mm256_loadu_pd(p);
+      const __m256d r1 = _mm256_loadu_pd(p + 4);
+      const __m256d r2 = _mm256_loadu_pd(p + 8);
+      mn0 = _mm256_min_pd(r0, mn0);
+      mx0 = _mm256_max_pd(r0, mx0);
+      mn1 = _mm256_min_pd(r1, mn1);
+      mx1 = _mm256_max_pd(r1, mx1);
+      mn2 = _mm256_min_pd(r2, mn2);
+      mx2 = _mm256_max_pd(r2, mx2);
+    }
+    _mm256_storeu_pd(lo, mn0);
+    _mm256_storeu_pd(lo + 4, mn1);
+    _mm256_storeu_pd(lo + 8, mn2);
+    _mm256_storeu_pd(hi, mx0);
+    _mm256_storeu_pd(hi + 4, mx1);
+    _mm256_storeu_pd(hi + 8, mx2);
+    // Компонента элемента k — k % 3, как в исходном потоке
+    for (int k = 0; k < 12; k += 3) {
+      Fold(b.min.x, b.max.x, lo[k], hi[k]);
+      Fold(b.min.y, b.max.y, lo[k + 1], hi[k + 1]);
+      Fold(b.min.z, b.max.z, lo[k + 2], hi[k + 2]);
+    }
+  } else {
+    const AffineAvx2 am(*m);
+    __m256d mnx = _mm256_set1_pd(b.min.x), mxx = mnx;
+    __m256d mny = _mm256_set1_pd(b.min.y), mxy = mny;
+    __m256d mnz = _mm256_set1_pd(b.min.z), mxz = mnz;
+    for (size_t i = 0; i < body; i += 4, p += 12) {
+      __m256d x, y, z;
+      Load4(p, x, y, z);
+      am.Apply(x, y, z);
+      mnx = _mm256_min_pd(x, mnx);
+      mxx = _mm256_max_pd(x, mxx);
+      mny = _mm256_min_pd(y, mny);
+      mxy = _mm256_max_pd(y, mxy);
+      mnz = _mm256_min_pd(z, mnz);
+      mxz = _mm256_max_pd(z, mxz);
+    }
+    _mm256_storeu_pd(lo, mnx);
+    _mm256_storeu_pd(lo + 4, mny);
+    _mm256_storeu_pd(lo + 8, mnz);
+    _mm256_storeu_pd(hi, mxx);
+    _mm256_storeu_pd(hi + 4, mxy);
+    _mm256_storeu_pd(hi + 8, mxz);
+    for (int k = 0; k < 4; ++k) {
+      Fold(b.min.x, b.max.x, lo[k], hi[k]);
+      Fold(b.min.y, b.max.y, lo[4 + k], hi[4 + k]);
+      Fold(b.min.z, b.max.z, lo[8 + k], hi[8 + k]);
+    }
+  }
+  BoundsTail(v, body, n, m, b);
+  return b;
+}
+
+S21_TARGET_AVX2 void TransformAvx2(Model::Vertex *v, size_t n,
+                                   const Model::Affine &m) {
+  const AffineAvx2 am(m);
+  const size_t body = n & ~size_t(3);
+  double *p = Raw(v);
+  for (size_t i = 0; i < body; i += 4, p += 12) {
+    __m256d x, y, z;
+    Load4(p, x, y, z);
+    am.Apply(x, y, z);
+    Store4(p, x, y, z);
+  }
+  TransformTail(v, body, n, m);
+}
+
+#else  // S21_FLOAT_VERTICES
+
+// Float-вершины: 4 вершины = 12 float = 3 регистра SSE, 8 вершин — AVX.
+// Тот же шаблон (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3) в каждой
+// 128-битной половине, перестановка в SoA — двумя shufps на компоненту.
+// Преобразование считается в float (скалярный путь — в double).
+
+constexpr int Sel(int a, int b, int c, int d) {
+  return a | b << 2 | c << 4 | d << 6;
+}
+
+// Элемент k свёрнутого потока относится к компоненте k % 3
+inline void FoldPattern(const float *lo, const float *hi, int count,
+                        Model::Aabb &b) {
+  for (int k = 0; k < count; k += 3) {
+    Fold(b.min.x, b.max.x, lo[k], hi[k]);
+    Fold(b.min.y, b.max.y, lo[k + 1], hi[k + 1]);
+    Fold(b.min.z, b.max.z, lo[k + 2], hi[k + 2]);
+  }
+}
+
+inline void FillPattern(const Model::Vertex &v, float *out, int count) {
+  for (int k = 0; k < count; k += 3) {
+    out[k] = v.x;
+    out[k + 1] = v.y;
+    out[k + 2] = v.z;
+  }
+}
+
+// ---------------------------------------------------------------- SSE2 ---
+
+inline void Deinterleave(__m128 a, __m128 b, __m128 c, __m128 &x, __m128 &y,
+                         __m128 &z) {
+  x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, Sel(2, 2, 1, 1)), Sel(0, 3, 0, 2));
+  y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, Sel(1, 1, 0, 0)),
+                     _mm_shuffle_ps(b, c, Sel(3, 3, 2, 2)), Sel(0, 2, 0, 2));
+  z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, Sel(2, 2, 1, 1)), c, Sel(0, 2, 0, 3));
+}
+
+inline void Interleave(__m128 x, __m128 y, __m128 z, __m128 &a, __m128 &b,
+                       __m128 &c) {
+  a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, Sel(0, 1, 0, 0)),
+                     _mm_shuffle_ps(z, x, Sel(0, 0, 1, 1)), Sel(0, 2, 0, 2));
+  b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, Sel(1, 1, 1, 1)),
+                     _mm_shuffle_ps(x, y, Sel(2, 2, 2, 2)), Sel(0, 2, 0, 2));
+  c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, Sel(2, 2, 3, 3)),
+                     _mm_shuffle_ps(y, z, Sel(3, 3, 3, 3)), Sel(0, 2, 0, 2));
+}
+
+struct AffineSse2 {
+  __m128 a[9], t[3];
+  explicit AffineSse2(const Model::Affine &m) {
+    for (int i = 0; i < 9; ++i) a[i] = _mm_set1_ps(static_cast<float>(m.a[i]));
+    for (int i = 0; i < 3; ++i) t[i] = _mm_set1_ps(static_cast<float>(m.t[i]));
+  }
+  void Apply(__m128 &x, __m128 &y, __m128 &z) const {
+    const __m128 nx = _mm_add_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], x), _mm_mul_ps(a[1], y)),
+                   _mm_mul_ps(a[2], z)),
+        t[0]);
+    const __m128 ny = _mm_add_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[3], x), _mm_mul_ps(a[4], y)),
+                   _mm_mul_ps(a[5], z)),
+        t[1]);
+    const __m128 nz = _mm_add_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[6], x), _mm_mul_ps(a[7], y)),
+                   _mm_mul_ps(a[8], z)),
+        t[2]);
+    x = nx;
+    y = ny;
+    z = nz;
+  }
+};
+
+Model::Aabb BoundsSse2(const Model::Vertex *v, size_t n,
+                       const Model::Affine *m) {
+  Model::Aabb b = Seed(v, m);
+  const size_t body = n & ~size_t(3);
+  const float *p = Raw(v);
+  float lo[12], hi[12];
+
+  if (!m) {
+    FillPattern(b.min, lo, 12);
+    __m128 mn0 = _mm_loadu_ps(lo), mx0 = mn0;
+    __m128 mn1 = _mm_loadu_ps(lo + 4), mx1 = mn1;
+    __m128 mn2 = _mm_loadu_ps(lo + 8), mx2 = mn2;
+    for (size_t i = 0; i < body; i += 4, p += 12) {
+      const __m128 r0 = _mm_loadu_ps(p);
+      const __m128 r1 = _mm_loadu_ps(p + 4);
+      const __m128 r2 = _mm_loadu_ps(p + 8);
+      mn0 = _mm_min_ps(r0, mn0);
+      mx0 = _mm_max_ps(r0, mx0);
+      mn1 = _mm_min_ps(r1, mn1);
+      mx1 = _mm_max_ps(r1, mx1);
+      mn2 = _mm_min_ps(r2, mn2);
+      mx2 = _mm_max_ps(r2, mx2);
+    }
+    _mm_storeu_ps(lo, mn0);
+    _mm_storeu_ps(lo + 4, mn1);
+    _mm_storeu_ps(lo + 8, mn2);
+    _mm_storeu_ps(hi, mx0);
+    _mm_storeu_ps(hi + 4, mx1);
+    _mm_storeu_ps(hi + 8, mx2);
+    FoldPattern(lo, hi, 12, b);
+  } else {
+    const AffineSse2 am(*m);
+    __m128 mnx = _mm_set1_ps(b.min.x), mxx = mnx;
+    __m128 mny = _mm_set1_ps(b.min.y), mxy = mny;
+    __m128 mnz = _mm_set1_ps(b.min.z), mxz = mnz;
+    for (size_t i = 0; i < body; i += 4, p += 12) {
+      __m128 x, y, z;
+      Deinterleave(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8),
+                   x, y, z);
+      am.Apply(x, y, z);
+      mnx = _mm_min_ps(x, mnx);
+      mxx = _mm_max_ps(x, mxx);
+      mny = _mm_min_ps(y, mny);
+      mxy = _mm_max_ps(y, mxy);
+      mnz = _mm_min_ps(z, mnz);
+      mxz = _mm_max_ps(z, mxz);
+    }
+    // Интерлив обратно даёт тот же шаблон x y z, что и без преобразования
+    __m128 a, bb, c;
+    Interleave(mnx, mny, mnz, a, bb, c);
+    _mm_storeu_ps(lo, a);
+    _mm_storeu_ps(lo + 4, bb);
+    _mm_storeu_ps(lo + 8, c);
+    Interleave(mxx, mxy, mxz, a, bb, c);
+    _mm_storeu_ps(hi, a);
+    _mm_storeu_ps(hi + 4, bb);
+    _mm_storeu_ps(hi + 8, c);
+    FoldPattern(lo, hi, 12, b);
+  }
+  BoundsTail(v, body, n, m, b);
+  return b;
+}
+
+void TransformSse2(Model::Vertex *v, size_t n, const Model::Affine &m) {
+  const AffineSse2 am(m);
+  const size_t body = n & ~size_t(3);
+  float *p = Raw(v);
+  for (size_t i = 0; i < body; i += 4, p += 12) {
+    __m128 x, y, z, a, b, c;
+    Deinterleave(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), x,
+                 y, z);
+    am.Apply(x, y, z);
+    Interleave(x, y, z, a, b, c);
+    _mm_storeu_ps(p, a);
+    _mm_storeu_ps(p + 4, b);
+    _mm_storeu_ps(p + 8, c);
+  }
+  TransformTail(v, body, n, m);
+}
+
+// ---------------------------------------------------------------- AVX2 ---
+// 8 вершин: половины регистров — вершины 0..3 и 4..7
+
+S21_TARGET_AVX2 inline __m256 LoadHalves(const float *lo, const float *hi) {
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)),
+                              _mm_loadu_ps(hi), 1);
+}
+
+S21_TARGET_AVX2 inline void StoreHalves(float *lo, float *hi, __m256 v) {
+  _mm_storeu_ps(lo, _mm256_castps256_ps128(v));
+  _mm_storeu_ps(hi, _mm256_extractf128_ps(v, 1));
+}
+
+S21_TARGET_AVX2 inline void Load8(const float *p, __m256 &x, __m256 &y,
+                                  __m256 &z) {
+  const __m256 a = LoadHalves(p, p + 12);
+  const __m256 b = LoadHalves(p + 4, p + 16);
+  const __m256 c = LoadHalves(p + 8, p + 20);
+  x = _mm256_shuffle_ps(a, _mm256_shuffle_ps(b, c, Sel(2, 2, 1, 1)),
+                        Sel(0, 3, 0, 2));
+  y = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, Sel(1, 1, 0, 0)),
+                        _mm256_shuffle_ps(b, c, Sel(3, 3, 2, 2)),
+                        Sel(0, 2, 0, 2));
+  z = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, Sel(2, 2, 1, 1)), c,
+                        Sel(0, 2, 0, 3));
+}
+
+S21_TARGET_AVX2 inline void Store8(float *p, __m256 x, __m256 y, __m256 z) {
+  const __m256 a = _mm256_shuffle_ps(_mm256_shuffle_ps(x, y, Sel(0, 1, 0, 0)),
+                                     _mm256_shuffle_ps(z, x, Sel(0, 0, 1, 1)),
+                                     Sel(0, 2, 0, 2));
+  const __m256 b = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, Sel(1, 1, 1, 1)),
+                                     _mm256_shuffle_ps(x, y, Sel(2, 2, 2, 2)),
+                                     Sel(0, 2, 0, 2));
+  const __m256 c = _mm256_shuffle_ps(_mm256_shuffle_ps(z, x, Sel(2, 2, 3, 3)),
+                                     _mm256_shuffle_ps(y, z, Sel(3, 3, 3, 3)),
+                                     Sel(0, 2, 0, 2));
+  StoreHalves(p, p + 12, a);
+  StoreHalves(p + 4, p + 16, b);
+  StoreHalves(p + 8, p + 20, c);
+}
+
+struct AffineAvx2 {
+  __m256 a[9], t[3];
+  S21_TARGET_AVX2 explicit AffineAvx2(const Model::Affine &m) {
+    for (int i = 0; i < 9; ++i)
+      a[i] = _mm256_set1_ps(static_cast<float>(m.a[i]));
+    for (int i = 0; i < 3; ++i)
+      t[i] = _mm256_set1_ps(static_cast<float>(m.t[i]));
+  }
+  S21_TARGET_AVX2 void Apply(__m256 &x, __m256 &y, __m256 &z) const {
+    const __m256 nx = _mm256_add_ps(
+        _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(a[0], x), _mm256_mul_ps(a[1], y)),
+            _mm256_mul_ps(a[2], z)),
+        t[0]);
+    const __m256 ny = _mm256_add_ps(
+        _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(a[3], x), _mm256_mul_ps(a[4], y)),
+            _mm256_mul_ps(a[5], z)),
+        t[1]);
+    const __m256 nz = _mm256_add_ps(
+        _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(a[6], x), _mm256_mul_ps(a[7], y)),
+            _mm256_mul_ps(a[8], z)),
+        t[2]);
+    x = nx;
+    y = ny;
+    z = nz;
+  }
+};
+
+S21_TARGET_AVX2 Model::Aabb BoundsAvx2(const Model::Vertex *v, size_t n,
+                                       const Model::Affine *m) {
+  Model::Aabb b = Seed(v, m);
+  const size_t body = n & ~size_t(7);
+  const float *p = Raw(v);
+  float lo[24], hi[24];
+
+  if (!m) {
+    // Поток подряд: 24 float, шаблон компонент k % 3
+    FillPattern(b.min, lo, 24);
+    __m256 mn0 = _mm256_loadu_ps(lo), mx0 = mn0;
+    __m256 mn1 = _mm256_loadu_ps(lo + 8), mx1 = mn1;
+    __m256 mn2 = _mm256_loadu_ps(lo + 16), mx2 = mn2;
+    for (size_t i = 0; i < body; i += 8, p += 24) {
+      const __m256 r0 = _mm256_loadu_ps(p);
+      const __m256 r1 = _mm256_loadu_ps(p + 8);
+      const __m256 r2 = _mm256_loadu_ps(p + 16);
+      mn0 = _mm256_min_ps(r0, mn0);
+      mx0 = _mm256_max_ps(r0, mx0);
+      mn1 = _mm256_min_ps(r1, mn1);
+      mx1 = _mm256_max_ps(r1, mx1);
+      mn2 = _mm256_min_ps(r2, mn2);
+      mx2 = _mm256_max_ps(r2, mx2);
+    }
+    _mm256_storeu_ps(lo, mn0);
+    _mm256_storeu_ps(lo + 8, mn1);
+    _mm256_storeu_ps(lo + 16, mn2);
+    _mm256_storeu_ps(hi, mx0);
+    _mm256_storeu_ps(hi + 8, mx1);
+    _mm256_storeu_ps(hi + 16, mx2);
+  } else {
+    const AffineAvx2 am(*m);
+    __m256 mnx = _mm256_set1_ps(b.min.x), mxx = mnx;
+    __m256 mny = _mm256_set1_ps(b.min.y), mxy = mny;
+    __m256 mnz = _mm256_set1_ps(b.min.z), mxz = mnz;
+    for (size_t i = 0; i < body; i += 8, p += 24) {
+      __m256 x, y, z;
+      Load8(p, x, y, z);
+      am.Apply(x, y, z);
+      mnx = _mm256_min_ps(x, mnx);
+      mxx = _mm256_max_ps(x, mxx);
+      mny = _mm256_min_ps(y, mny);
+      mxy = _mm256_max_ps(y, mxy);
+      mnz = _mm256_min_ps(z, mnz);
+      mxz = _mm256_max_ps(z, mxz);
+    }
+    Store8(lo, mnx, mny, mnz);
+    Store8(hi, mxx, mxy, mxz);
+  }
+  FoldPattern(lo, hi, 24, b);
+  BoundsTail(v, body, n, m, b);
+  return b;
+}
+
+S21_TARGET_AVX2 void TransformAvx2(Model::Vertex *v, size_t n,
+                                   const Model::Affine &m) {
+  const AffineAvx2 am(m);
+  const size_t body = n & ~size_t(7);
+  float *p = Raw(v);
+  for (size_t i = 0; i < body; i += 8, p += 24) {
+    __m256 x, y, z;
+    Load8(p, x, y, z);
+    am.Apply(x, y, z);
+    Store8(p, x, y, z);
+  }
+  TransformTail(v, body, n, m);
+}
+
+#endif  // S21_FLOAT_VERTICES
+
+#endif  // S21_VERTEX_KERNELS_X86
+
+std::atomic<int> g_level{-1};
+
+}  // namespace
+
+SimdLevel DetectSimdLevel() {
+#ifdef S21_VERTEX_KERNELS_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+  int r[4];
+  __cpuid(r, 0);
+  if (r[0] >= 7) {
+    __cpuid(r, 1);
+    const bool os_avx = (r[2] & (1 << 27)) && (r[2] & (1 << 28)) &&
+                        (_xgetbv(0) & 6) == 6;
+    __cpuidex(r, 7, 0);
+    if (os_avx && (r[1] & (1 << 5))) return SimdLevel::kAvx2;
+  }
+  return SimdLevel::kSse2;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") ? SimdLevel::kAvx2
+                                        : SimdLevel::kSse2;
+#endif
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+SimdLevel ActiveSimdLevel() {
+  int level = g_level.load(std::memory_order_relaxed);
+  if (level < 0) {
+    level = static_cast<int>(DetectSimdLevel());
+    g_level.store(level, std::memory_order_relaxed);
+  }
+  return static_cast<SimdLevel>(level);
+}
+
+void SetSimdLevel(SimdLevel level) {
+  const int best = static_cast<int>(DetectSimdLevel());
+  g_level.store(std::min(static_cast<int>(level), best),
+                std::memory_order_relaxed);
+}
+
+Model::Aabb ComputeBounds(const Model::Vertex *v, size_t n,
+                          const Model::Affine *m) {
+  switch (ActiveSimdLevel()) {
+#ifdef S21_VERTEX_KERNELS_X86
+    case SimdLevel::kAvx2:
+      return BoundsAvx2(v, n, m);
+    case SimdLevel::kSse2:
+      return BoundsSse2(v, n, m);
+#endif
+    default: {
+      Model::Aabb b = Seed(v, m);
+      BoundsTail(v, 1, n, m, b);
+      return b;
+    }
+  }
+}
+
+void TransformVertices(Model::Vertex *v, size_t n, const Model::Affine &m) {
+  switch (ActiveSimdLevel()) {
+#ifdef S21_VERTEX_KERNELS_X86
+    case SimdLevel::kAvx2:
+      TransformAvx2(v, n, m);
+      return;
+    case SimdLevel::kSse2:
+      TransformSse2(v, n, m);
+      return;
+#endif
+    default:
+      TransformTail(v, 0, n, m);
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,38 @@
+#ifndef S21_VERTEX_KERNELS_H
+#define S21_VERTEX_KERNELS_H
+
+#include <cstddef>
+
+#include "model/obj_model.h"
+
+// Векторные ядра над массивом вершин: AABB и аффинное преобразование.
+// Хранение остаётся AoS (x, y, z подряд), ядра переставляют данные в SoA
+// прямо в регистрах: 4 вершины на AVX2, 2 на SSE2. Набор инструкций
+// выбирается во время выполнения.
+
+namespace s21 {
+
+enum class SimdLevel {
+  kScalar,
+  kSse2,
+  kAvx2,
+};
+
+// Лучший уровень, поддерживаемый процессором
+SimdLevel DetectSimdLevel();
+// Текущий уровень (по умолчанию — DetectSimdLevel())
+SimdLevel ActiveSimdLevel();
+// Для тестов и бенчмарков; уровень выше доступного понижается
+void SetSimdLevel(SimdLevel level);
+
+// AABB образов m(v) для n > 0 вершин; m == nullptr — без преобразования.
+// Сравнения как в скалярном коде: (v < min) ? v : min.
+Model::Aabb ComputeBounds(const Model::Vertex *v, size_t n,
+                          const Model::Affine *m = nullptr);
+
+// v = m(v) на месте
+void TransformVertices(Model::Vertex *v, size_t n, const Model::Affine &m);
+
+}  // namespace s21
+
+#endif  // S21_VERTEX_KERNELS_H
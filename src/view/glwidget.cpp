@@ -2,14 +2,33 @@
 
 #include <QDebug>
 #include <QOpenGLBuffer>
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
 #include <QOpenGLShaderProgram>
 #include <QOpenGLVertexArrayObject>
+#include <QVector2D>
 #include <QVector4D>
 #include <QWheelEvent>
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <utility>
 
+#include "core/parallel.h"
+
+#ifndef GL_PRIMITIVE_RESTART
+#define GL_PRIMITIVE_RESTART 0x8F9D
+#endif
+#ifndef GL_TEXTURE_BUFFER
+#define GL_TEXTURE_BUFFER 0x8C2A
+#endif
+#ifndef GL_MAX_TEXTURE_BUFFER_SIZE
+#define GL_MAX_TEXTURE_BUFFER_SIZE 0x8C2B
+#endif
+#ifndef GL_R8UI
+#define GL_R8UI 0x8232
+#endif
+
 namespace s21 {
 
 GLWidget::GLWidget(QWidget *parent) : QOpenGLWidget(parent) {
@@ -32,9 +51,11 @@ void GLWidget::wheelEvent(QWheelEvent *e) {
     return;
   }
   if (dy > 0)
-    Scale(1.1f);
+    input_.scale *= 1.1;
   else if (dy < 0)
-    Scale(0.9f);
+    input_.scale *= 0.9;
+  input_.any = input_.any || dy != 0;
+  update();  // кадр заберёт накопленный ввод
   e->accept();
 }
 
@@ -69,57 +90,73 @@ void GLWidget::mouseMoveEvent(QMouseEvent *e) {
   const int dy = cur.y() - lastMousePos_.y();
 
   if (leftHeld) {
-    if (dx) transform_.rotate(dx * rotateSensitivity_, 0.f, 1.f, 0.f);
-    if (dy) transform_.rotate(dy * rotateSensitivity_, 1.f, 0.f, 0.f);
+    input_.rotateY += dx * rotateSensitivity_;
+    input_.rotateX += dy * rotateSensitivity_;
   }
   if (rightHeld) {
-    const float tx = dx * translateSensitivity_;
-    const float ty = -dy * translateSensitivity_;
-    transform_.translate(tx, ty, 0.f);
+    input_.moveX += dx * translateSensitivity_;
+    input_.moveY += -dy * translateSensitivity_;
   }
+  input_.any = input_.any || dx != 0 || dy != 0;
+  update();  // кадр заберёт накопленный ввод
 
   lastMousePos_ = cur;
-  update();
   e->accept();
 }
 
+// Накопленный ввод — одним запросом на ось. Повороты за кадр малы, и их
+// сложение вместо поочерёдного применения незаметно
+void GLWidget::flushInput() {
+  if (!input_.any) return;
+  const PendingInput in = std::exchange(input_, PendingInput{});
+  if (!model_) return;
+  flushingInput_ = true;
+  if (in.rotateY != 0) emit RotateRequested(1, in.rotateY);
+  if (in.rotateX != 0) emit RotateRequested(0, in.rotateX);
+  if (in.moveX != 0 || in.moveY != 0)
+    emit TranslateRequested(in.moveX, in.moveY, 0.0);
+  if (in.scale != 1) emit ScaleRequested(in.scale);
+  flushingInput_ = false;
+}
+
 /* =========================
  *        Слоты
  * ========================= */
 
 void GLWidget::Translate(float dx, float dy, float dz) {
   if (!model_) return;
-  transform_.translate(dx, dy, dz);
-  update();
+  emit TranslateRequested(dx, dy, dz);
 }
 
-void GLWidget::ResetTransform() {
-  transform_.setToIdentity();
-  update();
-}
+void GLWidget::ResetTransform() { emit ResetTransformRequested(); }
 
 void GLWidget::RotateX(float angle) {
   if (!model_) return;
-  transform_.rotate(angle, 1.f, 0.f, 0.f);
-  update();
+  emit RotateRequested(0, angle);
 }
 
 void GLWidget::RotateY(float angle) {
   if (!model_) return;
-  transform_.rotate(angle, 0.f, 1.f, 0.f);
-  update();
+  emit RotateRequested(1, angle);
 }
 
 void GLWidget::RotateZ(float angle) {
   if (!model_) return;
-  transform_.rotate(angle, 0.f, 0.f, 1.f);
-  update();
+  emit RotateRequested(2, angle);
 }
 
 void GLWidget::Scale(float factor) {
   if (!model_) return;
-  transform_.scale(factor);
-  update();
+  emit ScaleRequested(factor);
+}
+
+void GLWidget::SetTransform(const TransformState &state) {
+  float m[16];
+  state.ToRowMajor(m);
+  const QMatrix4x4 transform(m);
+  if (transform == transform_) return;
+  transform_ = transform;
+  markDirty(kDirtyMatrix);
 }
 
 // Переключение перспективной/ортографической проекции
@@ -142,15 +179,16 @@ void GLWidget::initializeGL() {
   initializeOpenGLFunctions();
 
   glEnable(GL_DEPTH_TEST);
+  // Постоянно: залитые примитивы (грани прохода глубины и каркаса по
+  // треугольникам) чуть отодвинуты, и рёбра на них проходят GL_LEQUAL
+  glDepthFunc(GL_LEQUAL);
+  glEnable(GL_POLYGON_OFFSET_FILL);
+  glPolygonOffset(1.0f, 1.0f);
   glDisable(GL_CULL_FACE);
   glDisable(GL_BLEND);
   glDisable(GL_LINE_SMOOTH);
   glHint(GL_LINE_SMOOTH_HINT, GL_FASTEST);
 
-  glLineWidth(settings_.edgeWidth);
-  glClearColor(settings_.background.redF(), settings_.background.greenF(),
-               settings_.background.blueF(), 1.0f);
-
   // --- Шейдер каркаса (линии) ---
   const char *vs_lines = R"(#version 330 core
         layout (location=0) in vec3 aPos;
@@ -181,6 +219,92 @@ void GLWidget::initializeGL() {
   u_color_ = program_.uniformLocation("uColor");
   u_dash_ = program_.uniformLocation("uDash");  // ← ВАЖНО
 
+  // --- Шейдер каркаса по треугольникам ---
+  // Геометрический шейдер передаёт каждой вершине треугольника её высоту
+  // в пикселях; после линейной (без перспективы) интерполяции компонента
+  // i — расстояние до стороны напротив вершины i. Пиксель остаётся, если
+  // он ближе полуширины линии к стороне, которая — ребро грани.
+  const char *vs_wire = R"(#version 330 core
+        layout (location=0) in vec3 aPos;
+        uniform mat4 uMVP;
+        void main(){ gl_Position = uMVP * vec4(aPos, 1.0); }
+    )";
+  const char *gs_wire = R"(#version 330 core
+        layout (triangles) in;
+        layout (triangle_strip, max_vertices = 3) out;
+        uniform vec2 uViewport;
+        uniform int  uAllEdges;           // 1 = все стороны — рёбра
+        uniform usamplerBuffer uEdgeMask; // бит i — сторона напротив i
+        noperspective out vec3 vDist;
+        flat out int vMask;
+        void main(){
+            // Треугольник через плоскость камеры в экран не проецируется
+            for (int i = 0; i < 3; ++i)
+                if (gl_in[i].gl_Position.w <= 0.0) return;
+            vec2 p[3];
+            for (int i = 0; i < 3; ++i)
+                p[i] = 0.5 * uViewport * gl_in[i].gl_Position.xy /
+                       gl_in[i].gl_Position.w;
+            vec2 e0 = p[2] - p[1], e1 = p[2] - p[0], e2 = p[1] - p[0];
+            float area = abs(e2.x * e1.y - e2.y * e1.x);
+            vec3 h = area / max(vec3(length(e0), length(e1), length(e2)),
+                                vec3(1e-6));
+            int mask = uAllEdges == 1
+                ? 7 : int(texelFetch(uEdgeMask, gl_PrimitiveIDIn).r);
+            for (int i = 0; i < 3; ++i) {
+                gl_Position = gl_in[i].gl_Position;
+                vDist = vec3(0.0);
+                vDist[i] = h[i];
+                vMask = mask;
+                EmitVertex();
+            }
+            EndPrimitive();
+        }
+    )";
+  const char *fs_wire = R"(#version 330 core
+        uniform vec4  uColor;
+        uniform int   uDash;
+        uniform float uHalfWidth;
+        noperspective in vec3 vDist;
+        flat in int vMask;
+        out vec4 FragColor;
+        void main(){
+            float d = 1e30;
+            for (int i = 0; i < 3; ++i)
+                if ((vMask & (1 << i)) != 0) d = min(d, vDist[i]);
+            if (d > uHalfWidth) discard;
+            if (uDash == 1) {
+                // тот же экранный пунктир, что у линий
+                float m = mod(floor(gl_FragCoord.x + gl_FragCoord.y), 8.0);
+                if (m < 4.0) discard;
+            }
+            FragColor = uColor;
+        }
+    )";
+
+  wireProgramOk_ =
+      program_wire_.addShaderFromSourceCode(QOpenGLShader::Vertex, vs_wire) &&
+      program_wire_.addShaderFromSourceCode(QOpenGLShader::Geometry,
+                                            gs_wire) &&
+      program_wire_.addShaderFromSourceCode(QOpenGLShader::Fragment,
+                                            fs_wire) &&
+      program_wire_.link();
+  if (!wireProgramOk_)
+    qWarning() << "Wireframe shader compile/link error:"
+               << program_wire_.log();
+  u_mvp_wire_ = program_wire_.uniformLocation("uMVP");
+  u_color_wire_ = program_wire_.uniformLocation("uColor");
+  u_dash_wire_ = program_wire_.uniformLocation("uDash");
+  u_half_width_wire_ = program_wire_.uniformLocation("uHalfWidth");
+  u_viewport_wire_ = program_wire_.uniformLocation("uViewport");
+  u_all_edges_wire_ = program_wire_.uniformLocation("uAllEdges");
+  u_edge_mask_wire_ = program_wire_.uniformLocation("uEdgeMask");
+  if (wireProgramOk_) {
+    program_wire_.bind();
+    program_wire_.setUniformValue(u_edge_mask_wire_, 0);  // блок текстур 0
+    program_wire_.release();
+  }
+
   // --- Шейдер вершин (точки) ---
   const char *vs_pts = R"(#version 330 core
         layout (location=0) in vec3 aPos;
@@ -231,13 +355,29 @@ void GLWidget::initializeGL() {
 
   vao_.bind();
   vbo_.bind();
-  // данные загрузим позже (в buildGpuBuffers*), здесь описываем формат
+  // данные загрузим позже (в syncGpuBuffers), здесь описываем формат
   glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
   glEnableVertexAttribArray(0);
   vbo_.release();
   vao_.release();
 
+  drawElementsBaseVertex_ = reinterpret_cast<DrawElementsBaseVertexFn>(
+      context()->getProcAddress("glDrawElementsBaseVertex"));
+  primitiveRestartIndex_ = reinterpret_cast<PrimitiveRestartIndexFn>(
+      context()->getProcAddress("glPrimitiveRestartIndex"));
+  texBuffer_ = reinterpret_cast<TexBufferFn>(
+      context()->getProcAddress("glTexBuffer"));
+  if (texBuffer_) glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexBufferSize_);
+  edgeMaskBuf_.create();
+  faceEbo_.create();
+  glGenTextures(1, &edgeMaskTex_);
+
+  // Новый контекст: всё состояние и все uniform'ы — заново
+  linesDash_ = -1;
+  markDirty(kDirtyAll);
+
   glReady_ = true;
+  syncGpuBuffers();  // модель могла быть задана до инициализации GL
 }
 
 void GLWidget::resizeGL(int w, int h) {
@@ -252,247 +392,627 @@ void GLWidget::updateProjectionMatrix(int w, int h) {
     projStrategy_ = std::make_unique<PerspectiveProjection>(45.f, 0.01f, 100.f);
   }
   proj_ = projStrategy_->Make(aspect);
-  update();
+  markDirty(kDirtyMatrix);
 }
 
 /* =========================
  *     Построение буферов
  * ========================= */
 
-void GLWidget::rebuildEdges() {
-  cpuEdges_.clear();
-  if (!model_) return;
+// Хранилище буфера под полную перезапись bytes байт (буфер привязан).
+// Прежнее хранилище «осиротевает» (glBufferData без данных): драйвер не
+// ждёт кадр, который его ещё читает. Ёмкость переиспользуется, пока новые
+// данные не больше её и не намного меньше.
+static void ReserveForRewrite(QOpenGLBuffer &buf, size_t &capacity,
+                              size_t bytes) {
+  if (bytes > capacity || bytes < capacity / 4) capacity = bytes;
+  buf.allocate(static_cast<int>(capacity));
+}
+
+// Перезагружает только изменившиеся части модели: вершины — по версии
+// геометрии (после правки части вершин — только её), рёбра — по версии
+// топологии. Контекст GL должен быть текущим.
+void GLWidget::syncGpuBuffers() {
+  if (!glReady_) return;  // догрузится в конце initializeGL()
+
+  if (!model_) {
+    if (gpuGeometry_ == 0 && gpuTopology_ == 0) return;
+    edgeIndexCount_ = 0;
+    edgeBatches_.clear();
+    wideIndexOffset_ = wideIndexCount_ = 0;
+    faceLoops_ = FaceLoopLayout{};
+    wireTriangles_ = WireTriangleLayout{};
+    faceTriangles_ = WireTriangleLayout{};
+    vertexCount_ = 0;
+    gpuGeometry_ = gpuTopology_ = gpuFaces_ = 0;
+    vboCapacity_ = eboCapacity_ = faceEboCapacity_ = 0;
+    vao_.bind();
+    vbo_.bind();
+    vbo_.allocate(nullptr, 0);
+    vbo_.release();
+    ebo_.bind();
+    ebo_.allocate(nullptr, 0);
+    ebo_.release();
+    faceEbo_.bind();
+    faceEbo_.allocate(nullptr, 0);
+    faceEbo_.release();
+    vao_.release();
+    markDirty(kDirtyBuffers);
+    return;
+  }
+
+  const bool geometry = model_->GeometryVersion() != gpuGeometry_;
+  const bool topology = model_->TopologyVersion() != gpuTopology_;
+  // Грани для скрытия линий; каркасу по треугольникам не нужны — если
+  // после перезаливки рёбер он останется таким, грани не зальются
+  const bool faces = settings_.hiddenLines &&
+                     model_->TopologyVersion() != gpuFaces_ &&
+                     (topology || wireTriangles_.triangles == 0);
+  vertexCount_ = static_cast<size_t>(model_->GetNumVertices());
+  if (!geometry && !topology && !faces) return;
 
   auto t0 = std::chrono::steady_clock::now();
+  vao_.bind();
 
-  std::vector<uint64_t> keys;
-  size_t estimate = 0;
-  const auto &polys = model_->GetPolygons();
-  for (const auto &p : polys) estimate += p.points_indices.size();
-  keys.reserve(estimate);
-
-  for (const auto &poly : polys) {
-    const auto &idx = poly.points_indices;
-    const size_t n = idx.size();
-    if (n < 2) continue;
-    for (size_t i = 0; i < n; ++i) {
-      uint32_t a = static_cast<uint32_t>(idx[i]);
-      uint32_t b = static_cast<uint32_t>(idx[(i + 1) % n]);
-      if (a == b) continue;
-      if (a > b) std::swap(a, b);
-      keys.push_back((uint64_t(a) << 32) | uint64_t(b));
+  size_t uploaded = 0;  // байт, ушедших на GPU
+  if (geometry) {
+    const auto &vs = model_->GetVertices();
+    constexpr size_t kStride = 3 * sizeof(float);
+    size_t first = 0, count = vs.size();
+    vbo_.bind();
+    if (!model_->ChangedVertices(gpuGeometry_, &first, &count)) {
+      first = 0;
+      count = vs.size();
+      ReserveForRewrite(vbo_, vboCapacity_, vs.size() * kStride);
+    }
+    if (count != 0) {
+#ifdef S21_FLOAT_VERTICES
+      // Раскладка Vertex совпадает с атрибутом (3 x float) — грузим как есть
+      static_assert(sizeof(Model::Vertex) == kStride,
+                    "Vertex must match the position attribute layout");
+      vbo_.write(static_cast<int>(first * kStride), vs.data() + first,
+                 static_cast<int>(count * kStride));
+#else
+      uploadConvertedVertices(vs, first, count);
+#endif
     }
+    vbo_.release();
+    uploaded += count * kStride;
+    gpuGeometry_ = model_->GeometryVersion();
   }
 
-  std::sort(keys.begin(), keys.end());
-  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
-
-  cpuEdges_.resize(keys.size() * 2);
-  for (size_t i = 0; i < keys.size(); ++i) {
-    cpuEdges_[2 * i] = static_cast<uint32_t>(keys[i] >> 32);
-    cpuEdges_[2 * i + 1] = static_cast<uint32_t>(keys[i] & 0xffffffffull);
+  if (topology) {
+    uploaded += uploadWireframe();
+    gpuTopology_ = model_->TopologyVersion();
   }
+  if (faces && wireTriangles_.triangles == 0) {
+    uploaded += uploadDepthFaces();
+    gpuFaces_ = model_->TopologyVersion();
+  }
+
+  vao_.release();
 
   auto t1 = std::chrono::steady_clock::now();
-  qDebug() << "[Perf] rebuildEdges:"
+  qDebug() << "[Perf] syncGpuBuffers:" << (geometry ? "vertices" : "")
+           << (topology ? "edges" : "") << (faces ? "faces" : "") << uploaded
+           << "bytes"
            << std::chrono::duration<double, std::milli>(t1 - t0).count()
            << "ms";
+  markDirty(kDirtyBuffers);
 }
 
-// Полный цикл (когда рёбра считает сам виджет) — для обратной совместимости
-void GLWidget::buildGpuBuffers() {
-  cpuVertices_.clear();
-  if (!model_) return;
-
-  auto t0 = std::chrono::steady_clock::now();
-
-  // Вершины (double -> float, один раз)
-  const auto &vs = model_->GetVertices();
-  cpuVertices_.reserve(vs.size() * 3);
-  for (const auto &v : vs) {
-    cpuVertices_.push_back(static_cast<float>(v.x));
-    cpuVertices_.push_back(static_cast<float>(v.y));
-    cpuVertices_.push_back(static_cast<float>(v.z));
+// Полная перезапись привязанного буфера индексов данными fill(dst):
+// сразу в отображённый буфер, при неудаче — через временный массив
+template <class Fill>
+static void RewriteIndices(QOpenGLBuffer &buf, size_t &capacity,
+                           size_t total, Fill fill) {
+  ReserveForRewrite(buf, capacity, total);
+  if (total == 0) return;
+  const int bytes = static_cast<int>(total);
+  void *mapped = buf.mapRange(
+      0, bytes, QOpenGLBuffer::RangeWrite | QOpenGLBuffer::RangeInvalidate);
+  if (mapped) {
+    fill(mapped);
+    if (buf.unmap()) return;
   }
+  std::vector<char> staging(total);
+  fill(staging.data());
+  buf.write(0, staging.data(), bytes);
+}
 
-  // Рёбра (медленно для больших моделей — лучше не в UI потоке)
-  rebuildEdges();
+// Каркас — уникальные рёбра (GL_LINES; индексы 16-битные, где позволяет
+// окно вершин), контуры граней или треугольники граней; индексы пишутся
+// параллельно по блокам. vao_ привязан.
+size_t GLWidget::uploadWireframe() {
+  edgeBatches_.clear();
+  wideIndexOffset_ = wideIndexCount_ = 0;
+  faceLoops_ = FaceLoopLayout{};
+  wireTriangles_ = WireTriangleLayout{};
+
+  size_t uploaded = 0;
+  if (settings_.wireframeMode == 3 && uploadWireTriangles(&uploaded))
+    return uploaded;
+
+  const auto &edges = model_->GetEdges();
+  const auto &offsets = model_->GetFaceOffsets();
+  const EdgeIndexLayout lines = PlanEdgeIndices(
+      edges, vertexCount_, drawElementsBaseVertex_ != nullptr);
+  const FaceLoopLayout loops = PlanFaceLoops(offsets, vertexCount_);
+  const bool useLoops = useFaceLoops(lines, loops);
+  qDebug() << "[Perf] wireframe: lines" << edges.size() << "indices"
+           << lines.bytes << "bytes, loops" << loops.count << "indices"
+           << loops.bytes << "bytes ->" << (useLoops ? "loops" : "lines");
 
-  // Аплоад в GPU
-  vao_.bind();
-
-  vbo_.bind();
-  if (!cpuVertices_.empty())
-    vbo_.allocate(cpuVertices_.data(),
-                  static_cast<int>(cpuVertices_.size() * sizeof(float)));
-  else
-    vbo_.allocate(nullptr, 0);
-  vbo_.release();
+  ebo_.bind();
+  if (useLoops) {
+    faceLoops_ = loops;
+    edgeIndexCount_ = loops.count;
+    RewriteIndices(ebo_, eboCapacity_, loops.bytes, [&](void *dst) {
+      WriteFaceLoops(offsets, model_->GetFaceIndices(), loops, dst);
+    });
+  } else {
+    edgeBatches_ = lines.batches;
+    wideIndexOffset_ = lines.wide_offset;
+    wideIndexCount_ = lines.wide_count;
+    edgeIndexCount_ = edges.size();
+    RewriteIndices(ebo_, eboCapacity_, lines.bytes, [&](void *dst) {
+      WriteEdgeIndices(edges, lines, dst);
+    });
+  }
+  ebo_.release();
+  return useLoops ? loops.bytes : lines.bytes;
+}
 
+bool GLWidget::uploadWireTriangles(size_t *uploaded) {
+  if (!wireProgramOk_) return false;
+  const auto &offsets = model_->GetFaceOffsets();
+  const WireTriangleLayout tris = PlanWireTriangles(offsets, vertexCount_);
+  // Маски нужны, если есть многоугольники, и должны влезть в текстуру
+  const bool fits =
+      tris.all_edges ||
+      (texBuffer_ && tris.triangles <= static_cast<size_t>(maxTexBufferSize_));
+  if (tris.triangles == 0 || !fits) return false;
+
+  std::vector<uint8_t> masks(tris.all_edges ? 0 : tris.triangles);
   ebo_.bind();
-  if (!cpuEdges_.empty())
-    ebo_.allocate(cpuEdges_.data(),
-                  static_cast<int>(cpuEdges_.size() * sizeof(uint32_t)));
-  else
-    ebo_.allocate(nullptr, 0);
+  RewriteIndices(ebo_, eboCapacity_, tris.bytes, [&](void *dst) {
+    WriteWireTriangles(offsets, model_->GetFaceIndices(), tris, dst,
+                       masks.empty() ? nullptr : masks.data());
+  });
   ebo_.release();
+  if (!masks.empty()) {
+    edgeMaskBuf_.bind();
+    edgeMaskBuf_.allocate(masks.data(), static_cast<int>(masks.size()));
+    edgeMaskBuf_.release();
+    glBindTexture(GL_TEXTURE_BUFFER, edgeMaskTex_);
+    texBuffer_(GL_TEXTURE_BUFFER, GL_R8UI, edgeMaskBuf_.bufferId());
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+  }
 
-  vao_.release();
+  wireTriangles_ = tris;
+  edgeIndexCount_ = 3 * tris.triangles;
+  *uploaded = tris.bytes + masks.size();
+  qDebug() << "[Perf] wireframe: triangles" << edgeIndexCount_ << "indices"
+           << tris.bytes << "bytes, edge masks" << masks.size() << "bytes";
+  return true;
+}
 
-  auto t1 = std::chrono::steady_clock::now();
-  qDebug() << "[Perf] buildGpuBuffers:"
-           << std::chrono::duration<double, std::milli>(t1 - t0).count()
-           << "ms";
+size_t GLWidget::uploadDepthFaces() {
+  const auto &offsets = model_->GetFaceOffsets();
+  faceTriangles_ = PlanWireTriangles(offsets, vertexCount_);
+  faceEbo_.bind();
+  RewriteIndices(faceEbo_, faceEboCapacity_, faceTriangles_.bytes,
+                 [&](void *dst) {
+                   WriteWireTriangles(offsets, model_->GetFaceIndices(),
+                                      faceTriangles_, dst, nullptr);
+                 });
+  faceEbo_.release();
+  return faceTriangles_.bytes;
 }
 
-// Быстрый путь: когда рёбра уже посчитаны в фоне
-void GLWidget::buildGpuBuffersWithEdges(std::vector<uint32_t> &&edges) {
-  cpuVertices_.clear();
-  cpuEdges_ = std::move(edges);
-  if (!model_) return;
+bool GLWidget::useFaceLoops(const EdgeIndexLayout &lines,
+                            const FaceLoopLayout &loops) const {
+  if (!primitiveRestartIndex_ || loops.count == 0) return false;
+  switch (settings_.wireframeMode) {
+    case 1:
+      return false;
+    case 2:
+      return true;
+    default:
+      return loops.bytes < lines.bytes;
+  }
+}
 
-  // Вершины (double -> float)
-  const auto &vs = model_->GetVertices();
-  cpuVertices_.reserve(vs.size() * 3);
-  for (const auto &v : vs) {
-    cpuVertices_.push_back(static_cast<float>(v.x));
-    cpuVertices_.push_back(static_cast<float>(v.y));
-    cpuVertices_.push_back(static_cast<float>(v.z));
+// double -> float прямо в отображённый диапазон vbo_ (он привязан и
+// размещён), параллельно по блокам: ни промежуточной копии в памяти, ни
+// пика потребления на время загрузки
+void GLWidget::uploadConvertedVertices(const std::vector<Model::Vertex> &vs,
+                                       size_t first, size_t count) {
+  const int offset = static_cast<int>(first * 3 * sizeof(float));
+  const int bytes = static_cast<int>(count * 3 * sizeof(float));
+  auto convert = [&vs, first, count](float *dst) {
+    const size_t blocks = (count + kConvertBlock - 1) / kConvertBlock;
+    ParallelFor(blocks, ResolveThreadCount(0), [&](size_t b) {
+      const size_t end = std::min(count, (b + 1) * kConvertBlock);
+      for (size_t i = b * kConvertBlock; i < end; ++i) {
+        const Model::Vertex &v = vs[first + i];
+        dst[3 * i] = static_cast<float>(v.x);
+        dst[3 * i + 1] = static_cast<float>(v.y);
+        dst[3 * i + 2] = static_cast<float>(v.z);
+      }
+    });
+  };
+
+  void *mapped = vbo_.mapRange(
+      offset, bytes,
+      QOpenGLBuffer::RangeWrite | QOpenGLBuffer::RangeInvalidate);
+  if (mapped) {
+    convert(static_cast<float *>(mapped));
+    // false — содержимое потеряно (например, при смене видеорежима)
+    if (vbo_.unmap()) return;
   }
+  // Отображение недоступно — через временный массив
+  std::vector<float> converted(count * 3);
+  convert(converted.data());
+  vbo_.write(offset, converted.data(), bytes);
+}
+
+/* =========================
+ *  Показ по ходу загрузки
+ * ========================= */
 
-  // Аплоад в GPU
+void GLWidget::AddLoadingChunk(uint64_t load, s21::LoadedChunkPtr chunk) {
+  if (!glReady_ || !chunk || chunk->index >= chunk->chunks) return;
+  makeCurrent();
+  if (load != loading_.load) beginLoading(load, *chunk);
+
+  LoadingState &s = loading_;
   vao_.bind();
+  if (chunk->kind == LoadedChunk::Kind::kVertices) {
+    // Вершины куска — сразу на своё место
+    if (!chunk->positions.empty()) {
+      vbo_.bind();
+      vbo_.write(static_cast<int>(chunk->first_vertex * 3 * sizeof(float)),
+                 chunk->positions.data(),
+                 static_cast<int>(chunk->positions.size() * sizeof(float)));
+      vbo_.release();
+    }
+    s.vertexCounts[chunk->index] = chunk->positions.size() / 3;
+  } else {
+    s.edges[chunk->index] = std::move(chunk);
+  }
+
+  // Префикс кусков: сначала вершины, за ними — рёбра на эти вершины
+  while (s.vertexChunks < s.chunks &&
+         s.vertexCounts[s.vertexChunks] != kMissing)
+    vertexCount_ += s.vertexCounts[s.vertexChunks++];
+  while (s.edgeChunks < s.vertexChunks && s.edges[s.edgeChunks]) {
+    appendLoadingEdges(s.edges[s.edgeChunks]->edges);
+    s.edges[s.edgeChunks++].reset();
+  }
+  vao_.release();
+  doneCurrent();
+  markDirty(kDirtyBuffers);
+}
 
+void GLWidget::beginLoading(uint64_t load, const LoadedChunk &chunk) {
+  // Прежняя модель (или показ прежней загрузки) уступает место новой
+  model_.reset();
+  transform_.setToIdentity();
+  markDirty(kDirtyMatrix);
+  loading_ = LoadingState{};
+  loading_.load = load;
+  loading_.chunks = chunk.chunks;
+  loading_.totalVertices = chunk.total_vertices;
+  loading_.vertexCounts.assign(chunk.chunks, kMissing);
+  loading_.edges.assign(chunk.chunks, nullptr);
+  // Части загрузки приходят 32-битными: раскладка — один хвост с нуля
+  edgeIndexCount_ = 0;
+  edgeBatches_.clear();
+  wideIndexOffset_ = wideIndexCount_ = 0;
+  faceLoops_ = FaceLoopLayout{};
+  wireTriangles_ = WireTriangleLayout{};
+  faceTriangles_ = WireTriangleLayout{};
+  vertexCount_ = 0;
+  gpuGeometry_ = gpuTopology_ = gpuFaces_ = kStaleVersion;
+
+  vao_.bind();
   vbo_.bind();
-  if (!cpuVertices_.empty())
-    vbo_.allocate(cpuVertices_.data(),
-                  static_cast<int>(cpuVertices_.size() * sizeof(float)));
-  else
-    vbo_.allocate(nullptr, 0);
+  vboCapacity_ = chunk.total_vertices * 3 * sizeof(float);
+  vbo_.allocate(static_cast<int>(vboCapacity_));
   vbo_.release();
-
   ebo_.bind();
-  if (!cpuEdges_.empty())
-    ebo_.allocate(cpuEdges_.data(),
-                  static_cast<int>(cpuEdges_.size() * sizeof(uint32_t)));
-  else
-    ebo_.allocate(nullptr, 0);
+  eboCapacity_ = 0;
+  ebo_.allocate(nullptr, 0);
   ebo_.release();
-
   vao_.release();
 }
 
+void GLWidget::appendLoadingEdges(const std::vector<uint32_t> &edges) {
+  if (edges.empty()) return;
+  LoadingState &s = loading_;
+  const size_t need = edgeIndexCount_ + edges.size();
+  if (need > s.edgeCapacity) {
+    // Размер — по пришедшим кускам с запасом; не хватило — переносим
+    // залитое копированием на GPU, без возврата данных в память
+    const size_t estimate = need * s.chunks / (s.edgeChunks + 1);
+    const size_t capacity =
+        std::max({need, estimate + estimate / 4, s.edgeCapacity * 2});
+    QOpenGLExtraFunctions *gl = context()->extraFunctions();
+    QOpenGLBuffer grown(QOpenGLBuffer::IndexBuffer);
+    grown.create();
+    gl->glBindBuffer(GL_COPY_WRITE_BUFFER, grown.bufferId());
+    gl->glBufferData(GL_COPY_WRITE_BUFFER,
+                     static_cast<GLsizeiptr>(capacity * sizeof(uint32_t)),
+                     nullptr, GL_STATIC_DRAW);
+    if (edgeIndexCount_ != 0) {
+      gl->glBindBuffer(GL_COPY_READ_BUFFER, ebo_.bufferId());
+      gl->glCopyBufferSubData(
+          GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+          static_cast<GLsizeiptr>(edgeIndexCount_ * sizeof(uint32_t)));
+      gl->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    gl->glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    ebo_.destroy();
+    ebo_ = grown;
+    s.edgeCapacity = capacity;
+    eboCapacity_ = capacity * sizeof(uint32_t);
+  }
+
+  ebo_.bind();
+  ebo_.write(static_cast<int>(edgeIndexCount_ * sizeof(uint32_t)),
+             edges.data(), static_cast<int>(edges.size() * sizeof(uint32_t)));
+  ebo_.release();
+  edgeIndexCount_ = wideIndexCount_ = need;
+}
+
 /* =========================
  *  Отрисовка одного кадра
  * ========================= */
 
+void GLWidget::markDirty(unsigned bits) {
+  frameDirty_ |= bits;
+  linesDirty_ |= bits;
+  wireDirty_ |= bits;
+  pointsDirty_ |= bits;
+  // Пачка изменений до кадра — один кадр: update() их объединяет
+  if (!flushingInput_) update();
+}
+
+void GLWidget::setLinesDash(int dash) {
+  if (dash == linesDash_) return;
+  program_.setUniformValue(u_dash_, dash);
+  linesDash_ = dash;
+}
+
+void GLWidget::pushLinesUniforms() {
+  const unsigned dirty = std::exchange(linesDirty_, 0u);
+  if (dirty & kDirtyMatrix) program_.setUniformValue(u_mvp_, mvp_);
+  if (dirty & kDirtyColors) program_.setUniformValue(u_color_, edgeColor_);
+}
+
+void GLWidget::pushWireUniforms() {
+  const unsigned dirty = std::exchange(wireDirty_, 0u);
+  if (dirty & kDirtyMatrix) {
+    const qreal dpr = devicePixelRatioF();
+    program_wire_.setUniformValue(u_mvp_wire_, mvp_);
+    program_wire_.setUniformValue(
+        u_viewport_wire_, QVector2D(static_cast<float>(width() * dpr),
+                                    static_cast<float>(height() * dpr)));
+  }
+  if (dirty & kDirtyColors)
+    program_wire_.setUniformValue(u_color_wire_, edgeColor_);
+  if (dirty & kDirtySettings) {
+    program_wire_.setUniformValue(u_dash_wire_,
+                                  settings_.edgeType == 1 ? 1 : 0);
+    // Толщина — как у glLineWidth, в пикселях кадра; тоньше пикселя
+    // линия рвётся
+    program_wire_.setUniformValue(u_half_width_wire_,
+                                  std::max(0.5f, settings_.edgeWidth * 0.5f));
+  }
+  if (dirty & kDirtyBuffers)
+    program_wire_.setUniformValue(u_all_edges_wire_,
+                                  wireTriangles_.all_edges ? 1 : 0);
+}
+
+void GLWidget::pushPointsUniforms() {
+  const unsigned dirty = std::exchange(pointsDirty_, 0u);
+  if (dirty & kDirtyMatrix) program_pts_.setUniformValue(u_mvp_pts_, mvp_);
+  if (dirty & kDirtyColors)
+    program_pts_.setUniformValue(u_color_pts_, vertexColor_);
+  if (dirty & kDirtySettings) {
+    program_pts_.setUniformValue(u_psize_pts_, settings_.vertexSize);
+    const int isCircle = (settings_.vertexType == 1) ? 1 : 0;
+    program_pts_.setUniformValue(u_circle_pts_, isCircle);
+  }
+}
+
 void GLWidget::paintGL() {
-  // Цвет фона из настроек (каждый кадр — чтобы изменения применялись сразу)
-  glClearColor(settings_.background.redF(), settings_.background.greenF(),
-               settings_.background.blueF(), 1.0f);
+  // Ввод, накопленный с прошлого кадра, попадает в этот
+  flushInput();
+
+  // Кадровое состояние — только изменившееся
+  const unsigned dirty = std::exchange(frameDirty_, 0u);
+  if (dirty & kDirtyColors) {
+    glClearColor(settings_.background.redF(), settings_.background.greenF(),
+                 settings_.background.blueF(), 1.0f);
+    edgeColor_ =
+        QVector4D(settings_.edgeColor.redF(), settings_.edgeColor.greenF(),
+                  settings_.edgeColor.blueF(), 1.0f);
+    vertexColor_ =
+        QVector4D(settings_.vertexColor.redF(), settings_.vertexColor.greenF(),
+                  settings_.vertexColor.blueF(), 1.0f);
+  }
+  if (dirty & kDirtySettings) glLineWidth(settings_.edgeWidth);
+  if (dirty & kDirtyMatrix) mvp_ = proj_ * view_ * transform_;
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+  // Модель ещё загружается — рисуем то, что уже пришло
+  const bool loading = loading_.load != 0;
 #ifndef NDEBUG
-  if (!model_) {
+  if (!model_ && !loading) {
     qDebug() << "[Paint] no model";
     return;
   }
-  if (cpuEdges_.empty()) {
+  if (edgeIndexCount_ == 0 && !loading) {
     qDebug() << "[Paint] no edges";
     return;
   }
 #else
-  if (!model_ || cpuEdges_.empty()) return;
+  if ((!model_ || edgeIndexCount_ == 0) && !loading) return;
 #endif
 
-  // Толщина линий из настроек
-  glLineWidth(settings_.edgeWidth);
-
-  const QMatrix4x4 mvp = proj_ * view_ * transform_;
+  // --- СКРЫТИЕ НЕВИДИМЫХ ЛИНИЙ ---
+  // Глубина граней заполняется заранее: рёбра за гранями отсекает ранний
+  // тест глубины, до фрагментного шейдера. Рёбра на самих гранях
+  // проходят — грани отодвинуты смещением полигонов, тест — GL_LEQUAL
+  if (settings_.hiddenLines && !loading) drawDepthPrepass();
 
   // --- ЛИНИИ (каркас) ---
-  program_.bind();
-  program_.setUniformValue(u_mvp_, mvp);
-  program_.setUniformValue(
-      u_color_,
-      QVector4D(settings_.edgeColor.redF(), settings_.edgeColor.greenF(),
-                settings_.edgeColor.blueF(), 1.0f));
-  program_.setUniformValue(u_dash_, settings_.edgeType == 1 ? 1 : 0);  // ← это
+  const bool lines =
+      !edgeBatches_.empty() || wideIndexCount_ != 0 || faceLoops_.count != 0;
+  if (lines) {
+    program_.bind();
+    pushLinesUniforms();
+    setLinesDash(settings_.edgeType == 1 ? 1 : 0);
 
-  vao_.bind();
-  ebo_.bind();
-  program_.setUniformValue(u_dash_, settings_.edgeType == 1 ? 1 : 0);
-  glDrawElements(GL_LINES, static_cast<GLsizei>(cpuEdges_.size()),
-                 GL_UNSIGNED_INT, nullptr);
-  ebo_.release();
-  vao_.release();
-  program_.release();
+    vao_.bind();
+    ebo_.bind();
+    for (const EdgeIndexBatch &b : edgeBatches_) {
+      const void *offset =
+          reinterpret_cast<const void *>(b.first * sizeof(uint16_t));
+      if (b.base_vertex == 0)
+        glDrawElements(GL_LINES, static_cast<GLsizei>(b.count),
+                       GL_UNSIGNED_SHORT, offset);
+      else
+        drawElementsBaseVertex_(GL_LINES, static_cast<GLsizei>(b.count),
+                                GL_UNSIGNED_SHORT, offset,
+                                static_cast<GLint>(b.base_vertex));
+    }
+    if (wideIndexCount_ != 0)
+      glDrawElements(GL_LINES, static_cast<GLsizei>(wideIndexCount_),
+                     GL_UNSIGNED_INT,
+                     reinterpret_cast<const void *>(wideIndexOffset_));
+    if (faceLoops_.count != 0) {
+      glEnable(GL_PRIMITIVE_RESTART);
+      primitiveRestartIndex_(faceLoops_.RestartIndex());
+      glDrawElements(GL_LINE_LOOP, static_cast<GLsizei>(faceLoops_.count),
+                     faceLoops_.narrow ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+                     nullptr);
+      glDisable(GL_PRIMITIVE_RESTART);
+    }
+    ebo_.release();
+    vao_.release();
+    program_.release();
+  }
+
+  // --- КАРКАС ПО ТРЕУГОЛЬНИКАМ ---
+  if (wireTriangles_.triangles != 0) {
+    program_wire_.bind();
+    pushWireUniforms();
+    glBindTexture(GL_TEXTURE_BUFFER, edgeMaskTex_);
+
+    vao_.bind();
+    ebo_.bind();
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(edgeIndexCount_),
+                   wireTriangles_.narrow ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+                   nullptr);
+    ebo_.release();
+    vao_.release();
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    program_wire_.release();
+  }
 
   // --- ВЕРШИНЫ (точки), если включено ---
-  // vertexType: 0=off, 1=circle, 2=square
-  if (settings_.vertexType != 0 && model_) {
+  // vertexType: 0=off, 1=circle, 2=square. Во время загрузки вершины
+  // видны всегда: они приходят раньше рёбер
+  if ((settings_.vertexType != 0 || loading) && vertexCount_ != 0) {
     program_pts_.bind();
-    program_pts_.setUniformValue(u_mvp_pts_, mvp);
-    program_pts_.setUniformValue(
-        u_color_pts_,
-        QVector4D(settings_.vertexColor.redF(), settings_.vertexColor.greenF(),
-                  settings_.vertexColor.blueF(), 1.0f));
-    program_pts_.setUniformValue(u_psize_pts_, settings_.vertexSize);
-    const int isCircle = (settings_.vertexType == 1) ? 1 : 0;
-    program_pts_.setUniformValue(u_circle_pts_, isCircle);
+    pushPointsUniforms();
 
     vao_.bind();  // атрибут location=0 уже описан в VAO
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(model_->GetNumVertices()));
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(vertexCount_));
     vao_.release();
 
     program_pts_.release();
   }
 }
 
+void GLWidget::drawDepthPrepass() {
+  // Каркас по треугольникам — сами грани уже в ebo_
+  const bool own = wireTriangles_.triangles != 0;
+  const WireTriangleLayout &tris = own ? wireTriangles_ : faceTriangles_;
+  if (tris.triangles == 0 || (!own && gpuFaces_ != gpuTopology_)) return;
+
+  program_.bind();
+  pushLinesUniforms();
+  setLinesDash(0);  // пунктир пробил бы дыры в глубине
+  glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+  vao_.bind();
+  QOpenGLBuffer &buf = own ? ebo_ : faceEbo_;
+  buf.bind();
+  glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(3 * tris.triangles),
+                 tris.narrow ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, nullptr);
+  buf.release();
+  vao_.release();
+
+  glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  program_.release();
+}
+
 /* =========================
  *     Привязка модели
  * ========================= */
 
-void GLWidget::SetModel(const s21::Model *model) {
-  model_ = model;
-  ResetTransform();
-  if (model_) {
-    buildGpuBuffers();  // медленнее — считает рёбра здесь
-  } else {
-    // очистка GPU-буферов
-    vao_.bind();
-    vbo_.bind();
-    vbo_.allocate(nullptr, 0);
-    vbo_.release();
-    ebo_.bind();
-    ebo_.allocate(nullptr, 0);
-    ebo_.release();
-    vao_.release();
-  }
+void GLWidget::SetModel(s21::ModelPtr model) {
+  // Показ по ходу загрузки этой модели уже залил все её вершины (те же
+  // float) — перезаливаются только рёбра
+  const LoadingState &s = loading_;
+  const bool keepVertices =
+      model && s.load != 0 && s.vertexChunks == s.chunks &&
+      s.totalVertices == static_cast<size_t>(model->GetNumVertices()) &&
+      !model->HasPendingTransform();
+  loading_ = LoadingState{};
+
+  model_ = std::move(model);
+  // Преобразование новой модели придёт от контроллера (SetTransform)
+  transform_.setToIdentity();
+  markDirty(kDirtyMatrix);
+  // Новая модель: залитые версии недействительны, перезагружаем всё
+  gpuGeometry_ = gpuTopology_ = gpuFaces_ = kStaleVersion;
+  if (keepVertices) gpuGeometry_ = model_->GeometryVersion();
+  SyncModel(model_);
 }
 
-void GLWidget::SetModelAndEdges(const s21::Model *model,
-                                std::vector<uint32_t> &&edges) {
-  model_ = model;
-  ResetTransform();
-  if (model_) {
-    buildGpuBuffersWithEdges(std::move(edges));  // быстрый путь
-  } else {
-    vao_.bind();
-    vbo_.bind();
-    vbo_.allocate(nullptr, 0);
-    vbo_.release();
-    ebo_.bind();
-    ebo_.allocate(nullptr, 0);
-    ebo_.release();
-    vao_.release();
-  }
+void GLWidget::SyncModel(s21::ModelPtr model) {
+  model_ = std::move(model);
+  if (!glReady_) return;
+  makeCurrent();
+  syncGpuBuffers();  // изменившиеся буферы сами заказывают кадр
+  doneCurrent();
 }
 
 void GLWidget::SetSettings(const RenderSettings &s) {
   const bool projChanged = (s.projectionType != settings_.projectionType);
+  const bool wireChanged = (s.wireframeMode != settings_.wireframeMode);
+  const bool hiddenOn = s.hiddenLines && !settings_.hiddenLines;
+  unsigned dirty = 0;
+  if (s.background != settings_.background ||
+      s.edgeColor != settings_.edgeColor ||
+      s.vertexColor != settings_.vertexColor)
+    dirty |= kDirtyColors;
+  if (s.edgeWidth != settings_.edgeWidth || s.edgeType != settings_.edgeType ||
+      s.vertexType != settings_.vertexType ||
+      s.vertexSize != settings_.vertexSize ||
+      s.hiddenLines != settings_.hiddenLines)
+    dirty |= kDirtySettings;
   settings_ = s;
 
+  // Другой вид каркаса — другой буфер индексов; скрытию линий нужны грани
+  if (wireChanged && model_) gpuTopology_ = kStaleVersion;
+  if ((wireChanged || hiddenOn) && model_) SyncModel(model_);
+
   if (projChanged) {
     if (settings_.projectionType == 0) {
       projStrategy_ =
@@ -503,7 +1023,7 @@ void GLWidget::SetSettings(const RenderSettings &s) {
     updateProjectionMatrix(width(), height());
   }
 
-  update();
+  if (dirty != 0) markDirty(dirty);
 }
 
 QImage GLWidget::GrabFrame() { return this->grabFramebuffer(); }
@@ -9,11 +9,15 @@
 #include <QOpenGLVertexArrayObject>
 #include <QOpenGLWidget>
 #include <QPoint>
+#include <QVector4D>
 #include <QWheelEvent>
 #include <cstdint>
 #include <vector>
 
+#include "model/edge_index_buffer.h"
+#include "model/load_control.h"
 #include "model/obj_model.h"
+#include "model/transform_state.h"
 #include "view/projection.h"
 #include "view/render_settings.h"
 
@@ -24,8 +28,15 @@ class GLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
  public:
   explicit GLWidget(QWidget *parent = nullptr);
 
-  void SetModel(const s21::Model *model);
-  void SetModelAndEdges(const s21::Model *model, std::vector<uint32_t> &&edges);
+  // Новая модель: сброс вида и полная загрузка буферов
+  void SetModel(s21::ModelPtr model);
+  // Новый снимок той же модели: перезагрузить только то, чья версия сменилась
+  void SyncModel(s21::ModelPtr model);
+  // Модельная матрица MVP; само состояние хранит контроллер
+  void SetTransform(const TransformState &state);
+  // Часть модели, ещё не загруженной до конца: рисуется сразу. Часть
+  // другой загрузки (load) начинает показ заново; SetModel его завершает.
+  void AddLoadingChunk(uint64_t load, s21::LoadedChunkPtr chunk);
 
   QImage GrabFrame();
   // ← ДОБАВЬ СЮДА (до public slots:)
@@ -39,6 +50,14 @@ class GLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
   void Translate(float dx, float dy, float dz);
   void ToggleProjection();
 
+ signals:
+  // Запросы преобразования от мыши, кнопок и записи GIF. Виджет сам
+  // матрицу не меняет: её пришлёт владелец состояния через SetTransform.
+  void RotateRequested(int axis, double deg);
+  void ScaleRequested(double factor);
+  void TranslateRequested(double dx, double dy, double dz);
+  void ResetTransformRequested();
+
  public:
   const RenderSettings &settings() const { return settings_; }
   void SetSettings(const RenderSettings &s);
@@ -53,7 +72,7 @@ class GLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
 
  private:
   bool glReady_ = false;  // ← станет true в конце initializeGL()
-  const s21::Model *model_ = nullptr;
+  s21::ModelPtr model_;  // держит снимок, пока он залит в буферы
   QMatrix4x4 transform_;
   QPoint lastMousePos_;
   float rotateSensitivity_ = 0.3f;
@@ -75,17 +94,140 @@ class GLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
   int u_mvp_ = -1;
   int u_color_ = -1;
 
-  std::vector<float> cpuVertices_;
-  std::vector<uint32_t> cpuEdges_;
+  size_t edgeIndexCount_ = 0;  // индексов рёбер в ebo_ всего
+  // Раскладка ebo_: 16-битные пакеты (с базовой вершиной у крупных
+  // моделей) и 32-битный хвост со смещения wideIndexOffset_ байт
+  std::vector<EdgeIndexBatch> edgeBatches_;
+  size_t wideIndexOffset_ = 0;
+  size_t wideIndexCount_ = 0;
+  // glDrawElementsBaseVertex (GL 3.2); nullptr — недоступна, и крупные
+  // модели рисуются 32-битными индексами
+  using DrawElementsBaseVertexFn = void(QOPENGLF_APIENTRYP)(
+      GLenum mode, GLsizei count, GLenum type, const void *indices,
+      GLint basevertex);
+  DrawElementsBaseVertexFn drawElementsBaseVertex_ = nullptr;
+  // Каркас контурами граней (count != 0): ebo_ целиком — GL_LINE_LOOP
+  // с перезапуском примитива, пакетов рёбер нет
+  FaceLoopLayout faceLoops_;
+  // glPrimitiveRestartIndex (GL 3.1); nullptr — только рёбра
+  using PrimitiveRestartIndexFn = void(QOPENGLF_APIENTRYP)(GLuint index);
+  PrimitiveRestartIndexFn primitiveRestartIndex_ = nullptr;
+  // Каркас по треугольникам (triangles != 0): ebo_ — GL_TRIANGLES граней,
+  // рёбра рисует program_wire_ по экранному расстоянию до сторон. Маски
+  // сторон — в текстурном буфере по gl_PrimitiveID (у моделей только
+  // из треугольников не нужны)
+  WireTriangleLayout wireTriangles_;
+  QOpenGLShaderProgram program_wire_;
+  bool wireProgramOk_ = false;
+  int u_mvp_wire_ = -1;
+  int u_color_wire_ = -1;
+  int u_dash_wire_ = -1;
+  int u_half_width_wire_ = -1;
+  int u_viewport_wire_ = -1;
+  int u_all_edges_wire_ = -1;
+  int u_edge_mask_wire_ = -1;
+  QOpenGLBuffer edgeMaskBuf_{QOpenGLBuffer::VertexBuffer};
+  GLuint edgeMaskTex_ = 0;
+  GLint maxTexBufferSize_ = 0;  // texel'ей в текстурном буфере не больше
+  // glTexBuffer (GL 3.1); nullptr — только модели из треугольников
+  using TexBufferFn = void(QOPENGLF_APIENTRYP)(GLenum target,
+                                               GLenum internalformat,
+                                               GLuint buffer);
+  TexBufferFn texBuffer_ = nullptr;
+  // Грани для скрытия невидимых линий: треугольники только в буфер
+  // глубины. Каркас по треугольникам обходится своим ebo_
+  QOpenGLBuffer faceEbo_{QOpenGLBuffer::IndexBuffer};
+  WireTriangleLayout faceTriangles_;
+  size_t faceEboCapacity_ = 0;
+  uint64_t gpuFaces_ = 0;  // версия топологии в faceEbo_
+  size_t vertexCount_ = 0;  // вершин в vbo_, которые можно рисовать
+  // Версии модели, залитые в vbo_/ebo_ (0 — буферы пусты)
+  static constexpr uint64_t kStaleVersion = ~uint64_t(0);
+  uint64_t gpuGeometry_ = 0;
+  uint64_t gpuTopology_ = 0;
+  // Размер хранилищ vbo_/ebo_ в байтах: полная перезапись того же или
+  // чуть меньшего объёма обходится без переразмещения
+  size_t vboCapacity_ = 0;
+  size_t eboCapacity_ = 0;
   QMatrix4x4 view_;
   QMatrix4x4 proj_;
 
   std::unique_ptr<IProjection> projStrategy_;
   RenderSettings settings_;
 
-  void rebuildEdges();
-  void buildGpuBuffers();
-  void buildGpuBuffersWithEdges(std::vector<uint32_t> &&edges);
+  // Показ по ходу загрузки. vbo_ размещается сразу на всю модель, ebo_
+  // растёт; рисуется непрерывный префикс кусков — рёбра куска ссылаются
+  // только на вершины его и предыдущих кусков
+  struct LoadingState {
+    uint64_t load = 0;  // 0 — показа нет
+    size_t chunks = 0;
+    size_t totalVertices = 0;
+    std::vector<size_t> vertexCounts;  // по кускам; kMissing — ещё нет
+    std::vector<s21::LoadedChunkPtr> edges;  // рёбра, ждущие своих вершин
+    size_t vertexChunks = 0;  // префикс кусков с залитыми вершинами
+    size_t edgeChunks = 0;    // префикс кусков с залитыми рёбрами
+    size_t edgeCapacity = 0;  // индексов, под которые размещён ebo_
+  };
+  static constexpr size_t kMissing = ~size_t(0);
+  LoadingState loading_;
+
+  void syncGpuBuffers();
+
+  // Кадр по требованию. Биты — что изменилось; кадр заказывается только
+  // изменением, и в драйвер уходит лишь изменившееся состояние
+  enum DirtyBits : unsigned {
+    kDirtyMatrix = 1u << 0,    // proj_ * view_ * transform_, размер кадра
+    kDirtyColors = 1u << 1,    // цвета фона, рёбер и вершин
+    kDirtySettings = 1u << 2,  // толщина, пунктир, вид и размер точек
+    kDirtyBuffers = 1u << 3,   // содержимое и раскладка буферов
+    kDirtyAll = ~0u,
+  };
+  // Кадровое состояние (фон, толщина, MVP) и uniform'ы каждой программы:
+  // программа получает накопленные биты, когда её рисуют
+  unsigned frameDirty_ = kDirtyAll;
+  unsigned linesDirty_ = kDirtyAll;
+  unsigned wireDirty_ = kDirtyAll;
+  unsigned pointsDirty_ = kDirtyAll;
+  QMatrix4x4 mvp_;
+  QVector4D edgeColor_;
+  QVector4D vertexColor_;
+  int linesDash_ = -1;  // uDash в program_ сейчас; -1 — не задан
+  void markDirty(unsigned bits);
+  // Uniform'ы программы, изменившиеся с её прошлого кадра (она привязана)
+  void pushLinesUniforms();
+  void pushWireUniforms();
+  void pushPointsUniforms();
+  void setLinesDash(int dash);
+
+  // Ввод мыши между кадрами копится и уходит одним запросом в начале
+  // кадра: пачка событий — одно изменение преобразования и один кадр
+  struct PendingInput {
+    double rotateX = 0, rotateY = 0;  // градусы
+    double moveX = 0, moveY = 0;
+    double scale = 1;
+    bool any = false;
+  };
+  PendingInput input_;
+  bool flushingInput_ = false;  // ответ на ввод попадёт в текущий кадр
+  void flushInput();
+  // Заливает в ebo_ индексы каркаса выбранного вида; возвращает байты
+  size_t uploadWireframe();
+  // Каркас по треугольникам, если он доступен; false — не залит
+  bool uploadWireTriangles(size_t *uploaded);
+  // Заливает в faceEbo_ треугольники граней для прохода глубины
+  size_t uploadDepthFaces();
+  // Проход глубины по граням (цвет не пишется, грани чуть отодвинуты)
+  void drawDepthPrepass();
+  // Рисовать ли каркас контурами граней: по настройке, в режиме «авто» —
+  // если их буфер меньше буфера рёбер
+  bool useFaceLoops(const EdgeIndexLayout &lines,
+                    const FaceLoopLayout &loops) const;
+  // Блок параллельного преобразования вершин при загрузке в vbo_
+  static constexpr size_t kConvertBlock = size_t(1) << 16;
+  void uploadConvertedVertices(const std::vector<Model::Vertex> &vs,
+                               size_t first, size_t count);
+  void beginLoading(uint64_t load, const LoadedChunk &chunk);
+  void appendLoadingEdges(const std::vector<uint32_t> &edges);
 
   void updateProjectionMatrix(int w, int h);
 };
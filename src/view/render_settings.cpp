@@ -14,6 +14,8 @@ void RenderSettings::Save(QSettings &st) const {
   st.setValue("edge_b", edgeColor.blue());
   st.setValue("edge_w", edgeWidth);
   st.setValue("edge_type", edgeType);
+  st.setValue("wire_mode", wireframeMode);
+  st.setValue("hidden_lines", hiddenLines);
 
   st.setValue("proj", projectionType);
 
@@ -38,6 +40,8 @@ void RenderSettings::Load(QSettings &st) {
   edgeColor.setBlue(st.value("edge_b", edgeColor.blue()).toInt());
   edgeWidth = st.value("edge_w", edgeWidth).toFloat();
   edgeType = st.value("edge_type", edgeType).toInt();
+  wireframeMode = st.value("wire_mode", wireframeMode).toInt();
+  hiddenLines = st.value("hidden_lines", hiddenLines).toBool();
 
   projectionType = st.value("proj", projectionType).toInt();
 
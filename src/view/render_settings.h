@@ -14,6 +14,13 @@ namespace s21
     float edgeWidth{1.5F};
     int projectionType{0};
     int edgeType{0};
+    // Каркас: 0 = авто (что меньше в буфере), 1 = уникальные рёбра
+    // (GL_LINES), 2 = контуры граней (GL_LINE_LOOP с перезапуском),
+    // 3 = треугольники граней, рёбра рисует шейдер (без буфера рёбер)
+    int wireframeMode{0};
+    // Скрытие невидимых линий: грани сперва рисуются только в буфер
+    // глубины, рёбра за ними отсекаются тестом глубины
+    bool hiddenLines{false};
     int vertexType{1};
     float vertexSize{4.0F};
     QColor vertexColor{255, 255, 255};
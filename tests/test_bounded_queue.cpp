@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "core/bounded_queue.h"
+
+namespace {
+
+using s21::BoundedQueue;
+
+TEST(BoundedQueue, FifoUpToCapacity) {
+  BoundedQueue<int> q(3);
+  ASSERT_EQ(q.Capacity(), 4u);
+  EXPECT_TRUE(q.Empty());
+  for (int i = 0; i < 4; ++i) EXPECT_TRUE(q.TryPush(i));
+  EXPECT_FALSE(q.TryPush(4));
+
+  int v = -1;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(q.TryPop(v));
+    EXPECT_EQ(v, i);
+  }
+  EXPECT_FALSE(q.TryPop(v));
+  EXPECT_TRUE(q.Empty());
+
+  // Кольцо переиспользует ячейки
+  for (int round = 0; round < 10; ++round) {
+    EXPECT_TRUE(q.TryPush(round));
+    ASSERT_TRUE(q.TryPop(v));
+    EXPECT_EQ(v, round);
+  }
+}
+
+// Каждый элемент доходит ровно до одного читателя
+TEST(BoundedQueue, ConcurrentProducersAndConsumers) {
+  constexpr int kProducers = 3;
+  constexpr int kConsumers = 3;
+  constexpr int kPerProducer = 20000;
+  BoundedQueue<int> q(16);
+  std::vector<std::atomic<int>> seen(kProducers * kPerProducer);
+  std::atomic<int> consumed{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kProducers; ++p)
+    threads.emplace_back([&, p] {
+      for (int i = 0; i < kPerProducer; ++i)
+        while (!q.TryPush(p * kPerProducer + i)) std::this_thread::yield();
+    });
+  for (int c = 0; c < kConsumers; ++c)
+    threads.emplace_back([&] {
+      int v = 0;
+      while (consumed.load() < kProducers * kPerProducer) {
+        if (q.TryPop(v)) {
+          seen[v].fetch_add(1);
+          consumed.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  for (auto &t : threads) t.join();
+
+  for (const auto &s : seen) ASSERT_EQ(s.load(), 1);
+  EXPECT_TRUE(q.Empty());
+}
+
+}  // namespace
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "model/edge_index_buffer.h"
+
+namespace {
+
+using Pairs = std::vector<std::pair<uint32_t, uint32_t>>;
+
+// Рёбра обратно из буфера: пакеты (база + локальный индекс) и 32-битный хвост
+Pairs Decode(const s21::EdgeIndexLayout &layout,
+             const std::vector<char> &buffer) {
+  Pairs out;
+  const auto *narrow = reinterpret_cast<const uint16_t *>(buffer.data());
+  for (const auto &b : layout.batches)
+    for (size_t i = b.first; i < b.first + b.count; i += 2)
+      out.emplace_back(b.base_vertex + narrow[i],
+                       b.base_vertex + narrow[i + 1]);
+  std::vector<uint32_t> wide(layout.wide_count);
+  std::memcpy(wide.data(), buffer.data() + layout.wide_offset,
+              wide.size() * sizeof(uint32_t));
+  for (size_t i = 0; i < wide.size(); i += 2)
+    out.emplace_back(wide[i], wide[i + 1]);
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+Pairs Sorted(const std::vector<uint32_t> &edges) {
+  Pairs out;
+  for (size_t i = 0; i < edges.size(); i += 2)
+    out.emplace_back(edges[i], edges[i + 1]);
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+std::vector<char> Write(const std::vector<uint32_t> &edges,
+                        const s21::EdgeIndexLayout &layout) {
+  std::vector<char> buffer(layout.bytes);
+  s21::WriteEdgeIndices(edges, layout, buffer.data(), 4);
+  return buffer;
+}
+
+TEST(EdgeIndexBuffer, SmallModelIsOneNarrowBatch) {
+  std::vector<uint32_t> edges;
+  for (uint32_t i = 0; i + 1 < 65536; i += 7) {
+    edges.push_back(i);
+    edges.push_back(65535 - i);
+  }
+  const auto layout = s21::PlanEdgeIndices(edges, 65536, true, 4);
+  ASSERT_EQ(layout.batches.size(), 1u);
+  EXPECT_EQ(layout.batches[0].base_vertex, 0u);
+  EXPECT_EQ(layout.wide_count, 0u);
+  // Вдвое меньше, чем 32-битные индексы
+  EXPECT_LE(layout.bytes, edges.size() * sizeof(uint16_t) + 2);
+  EXPECT_EQ(Decode(layout, Write(edges, layout)), Sorted(edges));
+}
+
+TEST(EdgeIndexBuffer, LargeModelUsesBaseVertexWindows) {
+  const uint32_t n = 300000;
+  std::vector<uint32_t> edges;
+  for (uint32_t i = 0; i + 1 < n; ++i) {
+    edges.push_back(i + 1);  // порядок концов сохраняется
+    edges.push_back(i);
+  }
+  // Длинные рёбра — через всю модель
+  for (uint32_t i = 0; i < 100; ++i) {
+    edges.push_back(i);
+    edges.push_back(n - 1 - i);
+  }
+  const auto layout = s21::PlanEdgeIndices(edges, n, true, 4);
+  EXPECT_GT(layout.batches.size(), 1u);
+  EXPECT_EQ(layout.wide_count, 200u);
+  for (const auto &b : layout.batches)
+    EXPECT_EQ(b.base_vertex % s21::kEdgeWindowStep, 0u);
+  EXPECT_EQ(layout.wide_offset % 4, 0u);
+  EXPECT_EQ(Decode(layout, Write(edges, layout)), Sorted(edges));
+
+  // Без базовой вершины — всё 32-битное
+  const auto wide = s21::PlanEdgeIndices(edges, n, false, 4);
+  EXPECT_TRUE(wide.batches.empty());
+  EXPECT_EQ(wide.wide_count, edges.size());
+  EXPECT_EQ(Decode(wide, Write(edges, wide)), Sorted(edges));
+}
+
+TEST(EdgeIndexBuffer, EmptyEdges) {
+  const auto layout = s21::PlanEdgeIndices({}, 10);
+  EXPECT_EQ(layout.bytes, 0u);
+  EXPECT_TRUE(layout.batches.empty());
+}
+
+TEST(EdgeIndexBuffer, FaceLoopsSeparatedByRestart) {
+  // Треугольник и пятиугольник
+  const std::vector<uint32_t> offsets = {0, 3, 8};
+  const std::vector<uint32_t> indices = {0, 1, 2, 2, 3, 4, 5, 6};
+  const auto narrow = s21::PlanFaceLoops(offsets, 7);
+  EXPECT_TRUE(narrow.narrow);
+  EXPECT_EQ(narrow.count, 10u);
+  std::vector<uint16_t> out16(narrow.count);
+  s21::WriteFaceLoops(offsets, indices, narrow, out16.data(), 4);
+  EXPECT_EQ(out16, (std::vector<uint16_t>{0, 1, 2, 0xFFFF, 2, 3, 4, 5, 6,
+                                          0xFFFF}));
+
+  // 65 536 вершин: 0xFFFF — уже номер вершины, нужны 32 бита
+  const auto wide = s21::PlanFaceLoops(offsets, 65536);
+  EXPECT_FALSE(wide.narrow);
+  EXPECT_EQ(wide.bytes, wide.count * sizeof(uint32_t));
+  std::vector<uint32_t> out32(wide.count);
+  s21::WriteFaceLoops(offsets, indices, wide, out32.data(), 4);
+  EXPECT_EQ(out32[3], 0xFFFFFFFFu);
+  EXPECT_EQ(out32[8], 6u);
+
+  EXPECT_EQ(s21::PlanFaceLoops({}, 10).count, 0u);
+}
+
+TEST(EdgeIndexBuffer, WireTrianglesMaskFanDiagonals) {
+  // Треугольник, отрезок (не рисуется) и пятиугольник
+  const std::vector<uint32_t> offsets = {0, 3, 5, 10};
+  const std::vector<uint32_t> indices = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  const auto layout = s21::PlanWireTriangles(offsets, 10, 4);
+  EXPECT_TRUE(layout.narrow);
+  EXPECT_FALSE(layout.all_edges);
+  ASSERT_EQ(layout.triangles, 4u);
+  std::vector<uint16_t> tris(3 * layout.triangles);
+  std::vector<uint8_t> masks(layout.triangles);
+  s21::WriteWireTriangles(offsets, indices, layout, tris.data(),
+                          masks.data(), 4);
+  EXPECT_EQ(tris, (std::vector<uint16_t>{0, 1, 2, 5, 6, 7, 5, 7, 8, 5, 8, 9}));
+  // Бит i — сторона напротив вершины i; диагонали веера погашены
+  EXPECT_EQ(masks, (std::vector<uint8_t>{7, 5, 1, 3}));
+
+  const auto only_tris = s21::PlanWireTriangles({0, 3, 6}, 70000, 4);
+  EXPECT_TRUE(only_tris.all_edges);
+  EXPECT_FALSE(only_tris.narrow);
+  EXPECT_EQ(only_tris.bytes, 6 * sizeof(uint32_t));
+}
+
+}  // namespace
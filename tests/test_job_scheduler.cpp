@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/job_scheduler.h"
+#include "core/parallel.h"
+
+namespace {
+
+using s21::JobPriority;
+using s21::JobScheduler;
+using s21::TaskGroup;
+
+// Занимает единственный поток пула, пока не вызван Release()
+class Blocker {
+ public:
+  explicit Blocker(JobScheduler &pool) {
+    pool.Submit([this] {
+      started_.set_value();
+      release_.get_future().wait();
+    });
+    started_.get_future().wait();
+  }
+  void Release() { release_.set_value(); }
+
+ private:
+  std::promise<void> started_;
+  std::promise<void> release_;
+};
+
+TEST(JobScheduler, HigherPriorityRunsFirst) {
+  JobScheduler pool(1);
+  Blocker blocker(pool);
+
+  std::mutex mutex;
+  std::vector<int> order;
+  TaskGroup group;
+  auto record = [&](int id) {
+    return [&, id] {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(id);
+    };
+  };
+  pool.Submit(record(2), JobPriority::kExport, &group);
+  pool.Submit(record(1), JobPriority::kLoad, &group);
+  pool.Submit(record(0), JobPriority::kInteractive, &group);
+  blocker.Release();
+  group.Wait();
+
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(JobScheduler, CancelledGroupSkipsQueuedTasks) {
+  JobScheduler pool(1);
+  Blocker blocker(pool);
+
+  std::atomic<int> ran{0};
+  TaskGroup group;
+  for (int i = 0; i < 10; ++i)
+    pool.Submit([&] { ++ran; }, JobPriority::kLoad, &group);
+  group.Cancel();
+  blocker.Release();
+  group.Wait();
+
+  EXPECT_TRUE(group.Done());
+  EXPECT_EQ(ran.load(), 0);
+}
+
+TEST(JobScheduler, ParallelForCoversRangeOnce) {
+  JobScheduler pool(3);
+  std::vector<std::atomic<int>> hits(10000);
+  pool.ParallelFor(hits.size(), 0, [&](size_t i) { ++hits[i]; });
+  for (const auto &h : hits) ASSERT_EQ(h.load(), 1);
+}
+
+TEST(JobScheduler, ParallelForRespectsThreadLimit) {
+  JobScheduler pool(4);
+  for (unsigned limit : {0u, 2u}) {
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    pool.ParallelFor(256, limit, [&](size_t) {
+      const int now = ++active;
+      int seen = peak.load();
+      while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+      --active;
+    });
+    // Пул из 4 потоков + вызывающий
+    EXPECT_LE(peak.load(), limit == 0 ? 5 : 2) << limit;
+  }
+}
+
+TEST(JobScheduler, NestedLoopsShareWorkers) {
+  // Вложенные циклы на занятом пуле не ждут свободных потоков
+  JobScheduler pool(2);
+  std::atomic<size_t> sum{0};
+  pool.ParallelFor(16, 0, [&](size_t i) {
+    pool.ParallelFor(100, 0, [&](size_t j) { sum += i * 100 + j; });
+  });
+  EXPECT_EQ(sum.load(), size_t(1600) * 1599 / 2);
+}
+
+TEST(JobScheduler, CancelStopsParallelFor) {
+  JobScheduler pool(2);
+  TaskGroup group;
+  std::atomic<size_t> done{0};
+  pool.ParallelFor(
+      1 << 20, 0,
+      [&](size_t i) {
+        if (i == 100) group.Cancel();
+        ++done;
+      },
+      &group);
+  EXPECT_LT(done.load(), size_t(1) << 20);
+}
+
+TEST(JobScheduler, WaitInsideTaskHelps) {
+  // Задача ждёт подзадачи на пуле из одного потока: ожидание выполняет их
+  JobScheduler pool(1);
+  std::promise<int> result;
+  pool.Submit([&] {
+    TaskGroup inner;
+    std::atomic<int> n{0};
+    for (int i = 0; i < 8; ++i)
+      pool.Submit([&] { ++n; }, JobPriority::kLoad, &inner);
+    inner.Wait();
+    result.set_value(n.load());
+  });
+  EXPECT_EQ(result.get_future().get(), 8);
+}
+
+TEST(JobScheduler, GlobalParallelForUsesSharedPool) {
+  std::atomic<size_t> sum{0};
+  s21::ParallelFor(1000, 8, [&](size_t i) { sum += i; });
+  EXPECT_EQ(sum.load(), size_t(1000) * 999 / 2);
+  EXPECT_GE(JobScheduler::Global().WorkerCount(), 1u);
+}
+
+}  // namespace
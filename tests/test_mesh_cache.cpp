@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "model/mesh_cache.h"
+#include "model/obj_model.h"
+#include "test_utils.h"
+
+namespace {
+
+constexpr const char kQuad[] =
+    "v 0 0 0\n"
+    "v 1 0 0\n"
+    "v 1 1 0\n"
+    "v 0 1 0.25\n"
+    "f 1 2 3 4\n"
+    "f -4 -2 -1\n";
+
+TEST(MeshCache, RoundTripRestoresModel) {
+  const std::string path = WriteTempObj(kQuad, "cache_rt.obj");
+  std::remove((path + ".s21mesh").c_str());
+
+  s21::CachedObjLoader loader;
+  s21::Model parsed;
+  ASSERT_TRUE(loader.Load(path, parsed));
+  EXPECT_FALSE(loader.LastLoadFromCache());
+
+  s21::Model cached;
+  ASSERT_TRUE(loader.Load(path, cached));
+  EXPECT_TRUE(loader.LastLoadFromCache());
+
+  ASSERT_EQ(cached.GetNumVertices(), parsed.GetNumVertices());
+  EXPECT_EQ(cached.GetNumEdges(), parsed.GetNumEdges());
+  EXPECT_EQ(cached.GetEdges(), parsed.GetEdges());
+  for (size_t i = 0; i < parsed.GetVertices().size(); ++i) {
+    EXPECT_EQ(cached.GetVertices()[i].x, parsed.GetVertices()[i].x);
+    EXPECT_EQ(cached.GetVertices()[i].y, parsed.GetVertices()[i].y);
+    EXPECT_EQ(cached.GetVertices()[i].z, parsed.GetVertices()[i].z);
+  }
+  ASSERT_EQ(cached.GetPolygons().size(), 2u);
+  EXPECT_EQ(cached.GetFaceOffsets(), parsed.GetFaceOffsets());
+  EXPECT_EQ(cached.GetFaceIndices(), parsed.GetFaceIndices());
+}
+
+TEST(MeshCache, ChangedSourceInvalidatesCache) {
+  const std::string path = WriteTempObj(kQuad, "cache_stale.obj");
+  s21::CachedObjLoader loader;
+  s21::Model m;
+  ASSERT_TRUE(loader.Load(path, m));
+
+  // Тот же размер, другое содержимое
+  std::string changed = kQuad;
+  changed[2] = '5';
+  WriteTempObj(changed, path);
+
+  s21::Model reloaded;
+  ASSERT_TRUE(loader.Load(path, reloaded));
+  EXPECT_FALSE(loader.LastLoadFromCache());
+  EXPECT_EQ(reloaded.GetVertices()[0].x, 5.0);
+}
+
+TEST(MeshCache, CorruptedSidecarIsRejected) {
+  const std::string path = WriteTempObj(kQuad, "cache_bad.obj");
+  s21::MeshCache cache;
+  s21::Model m;
+  std::string err;
+  ASSERT_TRUE(LoadModelFromObjString(kQuad, m, &err, path)) << err;
+  ASSERT_TRUE(cache.Store(path, m, &err)) << err;
+
+  {
+    std::fstream f(cache.SidecarPath(path),
+                   std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(0);
+    f.put('X');
+  }
+
+  s21::Model out;
+  EXPECT_FALSE(cache.Load(path, out, &err));
+  EXPECT_FALSE(err.empty());
+}
+
+}  // namespace
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "model/model_cache.h"
+#include "model/obj_model.h"
+#include "model/obj_parser.h"
+#include "test_utils.h"
+
+namespace {
+
+constexpr const char kTriangle[] =
+    "v 0 0 0\n"
+    "v 1 0 0\n"
+    "v 0 1 0\n"
+    "f 1 2 3\n";
+
+s21::ModelPtr LoadShared(const std::string &path) {
+  s21::ObjParser parser;
+  return s21::LoadSnapshot(parser, path);
+}
+
+TEST(ModelCache, HitReturnsSameSnapshot) {
+  const std::string path = WriteTempObj(kTriangle, "mcache_hit.obj");
+  s21::ModelCache cache;
+  const auto key = s21::ModelCache::MakeKey(path);
+  ASSERT_TRUE(key.valid());
+
+  EXPECT_EQ(cache.Find(key), nullptr);
+  s21::ModelPtr model = LoadShared(path);
+  cache.Insert(key, model);
+
+  EXPECT_EQ(cache.Find(s21::ModelCache::MakeKey(path)), model);
+  EXPECT_EQ(cache.stats().hits, 1u);
+  EXPECT_EQ(cache.stats().misses, 1u);
+  EXPECT_EQ(cache.stats().entries, 1u);
+  EXPECT_EQ(cache.stats().bytes, s21::ModelCache::ModelBytes(*model));
+}
+
+TEST(ModelCache, ChangedFileIsMiss) {
+  const std::string path = WriteTempObj(kTriangle, "mcache_stale.obj");
+  s21::ModelCache cache;
+  cache.Insert(s21::ModelCache::MakeKey(path), LoadShared(path));
+
+  WriteTempObj(std::string(kTriangle) + "v 5 5 5\n", path);
+  EXPECT_EQ(cache.Find(s21::ModelCache::MakeKey(path)), nullptr);
+  EXPECT_EQ(cache.stats().entries, 0u);
+  EXPECT_EQ(cache.stats().bytes, 0u);
+}
+
+TEST(ModelCache, EvictsLeastRecentlyUsed) {
+  const std::string a = WriteTempObj(kTriangle, "mcache_a.obj");
+  const std::string b = WriteTempObj(kTriangle, "mcache_b.obj");
+  const std::string c = WriteTempObj(kTriangle, "mcache_c.obj");
+  const s21::ModelPtr model = LoadShared(a);
+  const size_t bytes = s21::ModelCache::ModelBytes(*model);
+
+  // Помещаются ровно две модели
+  s21::ModelCache cache(2 * bytes);
+  cache.Insert(s21::ModelCache::MakeKey(a), LoadShared(a));
+  cache.Insert(s21::ModelCache::MakeKey(b), LoadShared(b));
+  ASSERT_NE(cache.Find(s21::ModelCache::MakeKey(a)), nullptr);  // a свежее b
+  cache.Insert(s21::ModelCache::MakeKey(c), LoadShared(c));
+
+  EXPECT_NE(cache.Find(s21::ModelCache::MakeKey(a)), nullptr);
+  EXPECT_EQ(cache.Find(s21::ModelCache::MakeKey(b)), nullptr);
+  EXPECT_NE(cache.Find(s21::ModelCache::MakeKey(c)), nullptr);
+  EXPECT_EQ(cache.stats().evictions, 1u);
+  EXPECT_EQ(cache.stats().bytes, 2 * bytes);
+
+  cache.SetBudget(bytes);
+  EXPECT_EQ(cache.stats().entries, 1u);
+  EXPECT_NE(cache.Find(s21::ModelCache::MakeKey(c)), nullptr);
+}
+
+TEST(ModelCache, ModelOverBudgetIsNotCached) {
+  const std::string path = WriteTempObj(kTriangle, "mcache_big.obj");
+  s21::ModelCache cache(8);
+  cache.Insert(s21::ModelCache::MakeKey(path), LoadShared(path));
+  EXPECT_EQ(cache.stats().entries, 0u);
+  EXPECT_FALSE(s21::ModelCache::MakeKey("mcache_missing.obj").valid());
+}
+
+}  // namespace
@@ -1,8 +1,11 @@
 // clazy:excludeall=non-pod-global-static
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
 #include <vector>
 
+#include "model/edge_builder.h"
 #include "model/obj_model.h"
 #include "test_utils.h" // WriteTempObj, LoadModelFromObjString
 
@@ -77,4 +80,81 @@ namespace
     EXPECT_TRUE(edges.empty());
   }
 
+  TEST(ModelEdges, SharedEdgesCountedOnce)
+  {
+    // два треугольника с общим ребром 1-3 и «отрезок» 1-2
+    constexpr const char kObj[] =
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "v 0 1 0\n"
+        "f 1 2 3\n"
+        "f 1 3 4\n"
+        "f 2 1\n";
+    s21::Model m;
+    std::string err;
+    ASSERT_TRUE(LoadModelFromObjString(kObj, m, &err, "shared.obj")) << err;
+
+    EXPECT_EQ(m.GetNumEdges(), 5);
+    EXPECT_EQ(m.GetEdges().size(), 10u);
+  }
+
+  // Все стратегии дают одно и то же множество рёбер
+  TEST(ModelEdges, StrategiesAgree)
+  {
+    const uint32_t kVertices = 5000;
+    std::mt19937 rng(42);
+    std::vector<uint32_t> offsets{0}, indices;
+    for (int f = 0; f < 40000; ++f)
+    {
+      const uint32_t n = 1 + rng() % 5;
+      const uint32_t base = rng() % (kVertices - 8);
+      for (uint32_t i = 0; i < n; ++i)
+      {
+        indices.push_back(base + rng() % 8);
+      }
+      offsets.push_back(static_cast<uint32_t>(indices.size()));
+    }
+
+    auto as_sorted_pairs = [](const std::vector<uint32_t> &e)
+    {
+      std::vector<std::pair<uint32_t, uint32_t>> p;
+      for (size_t i = 0; i + 1 < e.size(); i += 2)
+      {
+        p.emplace_back(e[i], e[i + 1]);
+      }
+      std::sort(p.begin(), p.end());
+      return p;
+    };
+
+    std::vector<uint32_t> reference;
+    s21::EdgeBuildOptions opt;
+    opt.strategy = s21::EdgeStrategy::kSort;
+    const size_t n_ref =
+        s21::ExtractUniqueEdges(offsets, indices, kVertices, reference, opt);
+    const auto ref_pairs = as_sorted_pairs(reference);
+    ASSERT_EQ(ref_pairs.size(), n_ref);
+    EXPECT_TRUE(std::adjacent_find(ref_pairs.begin(), ref_pairs.end()) ==
+                ref_pairs.end());
+    for (const auto &p : ref_pairs)
+    {
+      EXPECT_LT(p.first, p.second);
+    }
+
+    for (auto strategy : {s21::EdgeStrategy::kRadixSort,
+                          s21::EdgeStrategy::kHashSet})
+    {
+      for (unsigned threads : {1u, 4u})
+      {
+        std::vector<uint32_t> out;
+        opt.strategy = strategy;
+        opt.threads = threads;
+        EXPECT_EQ(s21::ExtractUniqueEdges(offsets, indices, kVertices, out,
+                                          opt),
+                  n_ref);
+        EXPECT_EQ(as_sorted_pairs(out), ref_pairs);
+      }
+    }
+  }
+
 } // namespace
@@ -0,0 +1,105 @@
+// clazy:excludeall=non-pod-global-static
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <future>
+#include <new>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include "model/obj_model.h"
+#include "model/obj_parser.h"
+#include "test_utils.h"
+
+// Счётчик байт, выделенных через operator new во всём процессе
+namespace {
+std::atomic<size_t> g_allocated{0};
+}  // namespace
+
+void *operator new(size_t size) {
+  g_allocated.fetch_add(size, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+// GCC не видит, что new выше — это malloc, и ругается на free
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+std::string MakeGridObj(int n) {
+  std::ostringstream os;
+  for (int y = 0; y < n; ++y)
+    for (int x = 0; x < n; ++x) os << "v " << x << ' ' << y << " 0\n";
+  for (int y = 0; y + 1 < n; ++y)
+    for (int x = 0; x + 1 < n; ++x) {
+      const int i = y * n + x + 1;
+      os << "f " << i << ' ' << i + 1 << ' ' << i + n + 1 << ' ' << i + n
+         << '\n';
+    }
+  return os.str();
+}
+
+TEST(ModelSnapshot, HandoffDoesNotCopyMesh) {
+  const std::string path = WriteTempObj(MakeGridObj(200), "snapshot.obj");
+
+  // Как в Controller::LoadAsync: загрузка в рабочем потоке, результат
+  // забирает поток UI через future
+  using ResultT = std::tuple<s21::ModelPtr, size_t, const s21::Model *>;
+  auto future = std::async(std::launch::async, [&path]() -> ResultT {
+    s21::ObjParser parser;
+    s21::ModelPtr m = s21::LoadSnapshot(parser, path);
+    const s21::Model *raw = m.get();
+    const size_t after_load = g_allocated.load();
+    return {std::move(m), after_load, raw};
+  });
+
+  ResultT result = future.get();
+  s21::ModelPtr controller_copy = std::get<0>(result);
+  s21::ModelPtr widget_copy = controller_copy;
+  const size_t handoff = g_allocated.load() - std::get<1>(result);
+
+  ASSERT_TRUE(controller_copy);
+  EXPECT_EQ(widget_copy.get(), std::get<2>(result));
+  EXPECT_EQ(controller_copy.use_count(), 3);
+
+  const s21::Model &m = *widget_copy;
+  ASSERT_EQ(m.GetNumVertices(), 200 * 200);
+  const size_t mesh_bytes = m.GetVertices().size() * sizeof(s21::Model::Vertex) +
+                            m.GetFaceIndices().size() * sizeof(uint32_t) +
+                            m.GetEdges().size() * sizeof(uint32_t);
+  // Передача снимка — только счётчик ссылок, данные модели не копируются
+  EXPECT_GT(mesh_bytes, size_t(1) << 20);
+  EXPECT_LT(handoff, size_t(1024));
+}
+
+TEST(ModelSnapshot, SnapshotIsReadyForSharedReads) {
+  const std::string path = WriteTempObj(MakeGridObj(4), "snapshot_small.obj");
+  s21::ObjParser parser;
+  s21::ModelPtr m = s21::LoadSnapshot(parser, path);
+  ASSERT_TRUE(m);
+  EXPECT_FALSE(m->HasPendingTransform());
+
+  // AABB посчитан при загрузке: чтение из двух потоков сразу ничего
+  // в модели не пишет
+  auto other = std::async(std::launch::async, [m] {
+    return m->ComputeAabb().max.x;
+  });
+  EXPECT_FLOAT_EQ(m->ComputeAabb().max.x, 3.0F);
+  EXPECT_FLOAT_EQ(other.get(), 3.0F);
+
+  std::string err;
+  EXPECT_FALSE(s21::LoadSnapshot(parser, "missing_snapshot.obj", &err));
+  EXPECT_FALSE(err.empty());
+}
+
+}  // namespace
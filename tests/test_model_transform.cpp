@@ -1,7 +1,10 @@
 // clazy:excludeall=non-pod-global-static
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <sstream>
 #include <string>
+#include <type_traits>
 
 #include "model/obj_model.h"
 #include "test_utils.h"
@@ -9,6 +12,10 @@
 namespace {
 
 constexpr double kEps = 1e-5;
+// Допуск сравнения двух путей запекания: на float-вершинах каждое
+// промежуточное запекание округляет координаты
+constexpr double kBakeEps =
+    std::is_same<s21::Model::Scalar, float>::value ? 1e-4 : 1e-9;
 
 TEST(ModelTransform, Translate) {
   constexpr const char kObj[] = "v 0 0 0\n";
@@ -109,4 +116,256 @@ TEST(ModelTransform, TranslateZeroDoesNothing) {
   EXPECT_EQ(before.max.z, after.max.z);
 }
 
+// Серия преобразований копится без записи в вершины и запекается
+// в тот же результат, что и пошаговое применение
+TEST(ModelTransform, DeferredMatchesStepwise) {
+  constexpr const char kObj[] =
+      "v 1 2 3\n"
+      "v -4 0.5 2\n"
+      "v 0 -3 -1\n"
+      "v 2 2 -2\n";
+  s21::Model deferred;
+  std::string err;
+  ASSERT_TRUE(LoadModelFromObjString(kObj, deferred, &err, "df.obj")) << err;
+
+  auto ops = [](s21::Model &m) {
+    m.RotateX(30.0);
+    m.Translate(1.0, -2.0, 0.5);
+    m.Scale(1.5);
+    m.RotateY(-45.0);
+    m.RotateZ(120.0);
+    m.Scale(0.25);
+  };
+  ops(deferred);
+  EXPECT_TRUE(deferred.HasPendingTransform());
+
+  // Эталон: запекание после каждой операции
+  s21::Model stepwise;
+  ASSERT_TRUE(LoadModelFromObjString(kObj, stepwise, &err, "sw.obj")) << err;
+  stepwise.RotateX(30.0);
+  stepwise.Bake();
+  stepwise.Translate(1.0, -2.0, 0.5);
+  stepwise.Bake();
+  stepwise.Scale(1.5);
+  stepwise.Bake();
+  stepwise.RotateY(-45.0);
+  stepwise.Bake();
+  stepwise.RotateZ(120.0);
+  stepwise.Bake();
+  stepwise.Scale(0.25);
+
+  const auto box = deferred.ComputeAabb();
+  EXPECT_TRUE(deferred.HasPendingTransform());  // AABB не запекает
+
+  const auto &a = deferred.GetVertices();
+  const auto &b = stepwise.GetVertices();
+  EXPECT_FALSE(deferred.HasPendingTransform());
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    EXPECT_NEAR(a[i].x, b[i].x, kBakeEps);
+    EXPECT_NEAR(a[i].y, b[i].y, kBakeEps);
+    EXPECT_NEAR(a[i].z, b[i].z, kBakeEps);
+  }
+
+  const auto ref = stepwise.ComputeAabb();
+  EXPECT_NEAR(box.min.x, ref.min.x, kBakeEps);
+  EXPECT_NEAR(box.min.y, ref.min.y, kBakeEps);
+  EXPECT_NEAR(box.min.z, ref.min.z, kBakeEps);
+  EXPECT_NEAR(box.max.x, ref.max.x, kBakeEps);
+  EXPECT_NEAR(box.max.y, ref.max.y, kBakeEps);
+  EXPECT_NEAR(box.max.z, ref.max.z, kBakeEps);
+}
+
+// Отрицательный масштаб сохраняет корректный порядок min/max
+TEST(ModelTransform, NegativeScaleKeepsAabbOrdered) {
+  constexpr const char kObj[] =
+      "v 0 0 0\n"
+      "v 2 4 6\n";
+  s21::Model m;
+  std::string err;
+  ASSERT_TRUE(LoadModelFromObjString(kObj, m, &err, "neg.obj")) << err;
+
+  m.Scale(-1.0);
+  auto aabb = m.ComputeAabb();
+  EXPECT_NEAR(aabb.min.x, 0.0, kEps);
+  EXPECT_NEAR(aabb.max.x, 2.0, kEps);
+  EXPECT_NEAR(aabb.min.z, 0.0, kEps);
+  EXPECT_NEAR(aabb.max.z, 6.0, kEps);
+
+  const auto &vs = m.GetVertices();
+  EXPECT_NEAR(vs[0].x, 2.0, kEps);
+  EXPECT_NEAR(vs[1].y, 0.0, kEps);
+}
+
+// Большая модель: параллельный и последовательный пути дают одно и то же
+TEST(ModelTransform, ParallelPathMatchesSequential) {
+  std::ostringstream obj;
+  for (int i = 0; i < 150000; ++i)
+    obj << "v " << (i % 397) * 0.01 << ' ' << (i % 211) * -0.02 << ' '
+        << (i * 7 % 1009) * 0.003 << '\n';
+
+  s21::Model seq, par;
+  std::string err;
+  ASSERT_TRUE(LoadModelFromObjString(obj.str(), seq, &err, "big.obj")) << err;
+  ASSERT_TRUE(LoadModelFromObjString(obj.str(), par, &err, "big.obj")) << err;
+  seq.SetParallelThreshold(std::numeric_limits<size_t>::max());
+  par.SetParallelThreshold(0);
+  par.SetThreadCount(4);
+
+  auto ops = [](s21::Model &m) {
+    m.RotateX(17.0);
+    m.Scale(1.3);
+    m.RotateY(-40.0);
+    m.Translate(0.5, 0.0, -2.0);
+    m.RotateZ(75.0);
+  };
+  ops(seq);
+  ops(par);
+
+  const auto a = seq.ComputeExactAabb();
+  const auto b = par.ComputeExactAabb();
+  EXPECT_EQ(a.min.x, b.min.x);
+  EXPECT_EQ(a.min.y, b.min.y);
+  EXPECT_EQ(a.min.z, b.min.z);
+  EXPECT_EQ(a.max.x, b.max.x);
+  EXPECT_EQ(a.max.y, b.max.y);
+  EXPECT_EQ(a.max.z, b.max.z);
+
+  const auto &vs = seq.GetVertices();
+  const auto &vp = par.GetVertices();
+  ASSERT_EQ(vs.size(), vp.size());
+  size_t mismatches = 0;
+  for (size_t i = 0; i < vs.size(); ++i)
+    mismatches +=
+        vs[i].x != vp[i].x || vs[i].y != vp[i].y || vs[i].z != vp[i].z;
+  EXPECT_EQ(mismatches, 0u);
+}
+
+// После поворота AABB по углам охватывает точный и не требует прохода
+TEST(ModelTransform, RotatedAabbIsConservative) {
+  constexpr const char kObj[] =
+      "v 0 0 0\n"
+      "v 4 0 0\n"
+      "v 0 2 0\n"
+      "v 1 1 3\n";
+  s21::Model m;
+  std::string err;
+  ASSERT_TRUE(LoadModelFromObjString(kObj, m, &err, "cons.obj")) << err;
+
+  m.Translate(1.0, 2.0, 3.0);
+  m.Scale(0.5);
+  EXPECT_TRUE(m.IsAabbExact());
+
+  m.RotateY(30.0);
+  m.RotateX(-50.0);
+  EXPECT_FALSE(m.IsAabbExact());
+
+  const auto bound = m.ComputeAabb();
+  const auto exact = m.ComputeExactAabb();
+  EXPECT_LE(bound.min.x, exact.min.x + kEps);
+  EXPECT_LE(bound.min.y, exact.min.y + kEps);
+  EXPECT_LE(bound.min.z, exact.min.z + kEps);
+  EXPECT_GE(bound.max.x, exact.max.x - kEps);
+  EXPECT_GE(bound.max.y, exact.max.y - kEps);
+  EXPECT_GE(bound.max.z, exact.max.z - kEps);
+}
+
+// Опорная точка серии поворотов неподвижна: полный оборот
+// возвращает модель на место
+TEST(ModelTransform, FullTurnReturnsToStart) {
+  constexpr const char kObj[] =
+      "v 0 0 0\n"
+      "v 3 0 1\n"
+      "v 0 1 0\n";
+  s21::Model m;
+  std::string err;
+  ASSERT_TRUE(LoadModelFromObjString(kObj, m, &err, "turn.obj")) << err;
+  const auto before = m.GetVertices();
+
+  for (int i = 0; i < 36; ++i) m.RotateZ(10.0);
+
+  const auto &after = m.GetVertices();
+  ASSERT_EQ(after.size(), before.size());
+  for (size_t i = 0; i < after.size(); ++i) {
+    EXPECT_NEAR(after[i].x, before[i].x, kEps);
+    EXPECT_NEAR(after[i].y, before[i].y, kEps);
+    EXPECT_NEAR(after[i].z, before[i].z, kEps);
+  }
+}
+
+// Преобразования меняют только версию геометрии, запекание — ничего
+TEST(ModelTransform, VersionsTrackChanges) {
+  constexpr const char kObj[] =
+      "v 0 0 0\n"
+      "v 1 0 0\n"
+      "v 0 1 0\n"
+      "f 1 2 3\n";
+  s21::Model m;
+  std::string err;
+  ASSERT_TRUE(LoadModelFromObjString(kObj, m, &err, "ver.obj")) << err;
+  const uint64_t topo = m.TopologyVersion();
+  const uint64_t geom = m.GeometryVersion();
+  EXPECT_NE(topo, 0u);
+  EXPECT_NE(geom, 0u);
+
+  m.RotateX(15.0);
+  EXPECT_EQ(m.TopologyVersion(), topo);
+  EXPECT_NE(m.GeometryVersion(), geom);
+
+  const uint64_t rotated = m.GeometryVersion();
+  m.Scale(1.0);
+  m.GetVertices();
+  EXPECT_EQ(m.GeometryVersion(), rotated);
+
+  // Повторная загрузка — новые версии, даже для того же файла
+  ASSERT_TRUE(LoadModelFromObjString(kObj, m, &err, "ver.obj")) << err;
+  EXPECT_NE(m.TopologyVersion(), topo);
+  EXPECT_NE(m.GeometryVersion(), rotated);
+}
+
+// Правки части вершин копят один диапазон: потребитель, видевший версию
+// до первой правки, перезаливает только его, остальные — всё
+TEST(ModelTransform, UpdateVerticesReportsChangedRange) {
+  constexpr const char kObj[] =
+      "v 0 0 0\n"
+      "v 1 0 0\n"
+      "v 0 1 0\n"
+      "v 0 0 1\n"
+      "f 1 2 3 4\n";
+  s21::Model m;
+  std::string err;
+  ASSERT_TRUE(LoadModelFromObjString(kObj, m, &err, "upd.obj")) << err;
+  const uint64_t topo = m.TopologyVersion();
+  const uint64_t loaded = m.GeometryVersion();
+  size_t first = 7, count = 7;
+  ASSERT_TRUE(m.ChangedVertices(loaded, &first, &count));
+  EXPECT_EQ(count, 0u);
+
+  m.Translate(1.0, 0.0, 0.0);
+  const uint64_t moved = m.GeometryVersion();
+  const s21::Model::Vertex v[] = {{5, 5, 5}};
+  m.UpdateVertices(2, v, 1);
+  EXPECT_EQ(m.TopologyVersion(), topo);
+  EXPECT_NE(m.GeometryVersion(), moved);
+  EXPECT_NEAR(m.GetVertices()[2].x, 5.0, kEps);
+  EXPECT_NEAR(m.GetVertices()[1].x, 2.0, kEps);  // сдвиг запечён
+  EXPECT_NEAR(m.ComputeAabb().max.x, 5.0, kEps);
+
+  ASSERT_TRUE(m.ChangedVertices(moved, &first, &count));
+  EXPECT_EQ(first, 2u);
+  EXPECT_EQ(count, 1u);
+
+  const uint64_t one_edit = m.GeometryVersion();
+  m.UpdateVertices(0, v, 1);
+  ASSERT_TRUE(m.ChangedVertices(moved, &first, &count));
+  EXPECT_EQ(first, 0u);
+  EXPECT_EQ(count, 3u);
+  EXPECT_FALSE(m.ChangedVertices(one_edit, &first, &count));
+  EXPECT_FALSE(m.ChangedVertices(loaded, &first, &count));
+
+  // Преобразование целиком — снова полная перезагрузка
+  m.Translate(0.0, 1.0, 0.0);
+  EXPECT_FALSE(m.ChangedVertices(moved, &first, &count));
+}
+
 }  // namespace
@@ -1,8 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <mutex>
+#include <random>
+#include <set>
 #include <string>
+#include <vector>
 
+#include "model/fast_number.h"
 #include "model/obj_model.h"
 #include "model/obj_parser.h"
 
@@ -67,4 +75,315 @@ TEST(ObjParser, EmptyFile) {
   EXPECT_TRUE(model.GetPolygons().empty());
 }
 
+TEST(ObjParser, FacesAreStoredAsCsr) {
+  const std::string path = WriteTempObj(
+      "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+      "f 1 2 3\nf\nf 1/1 2/2 3/3 4/4\nf 9 10\n",
+      "csr.obj");
+  s21::Model model;
+  s21::ObjParser parser;
+  ASSERT_TRUE(parser.Load(path, model));
+
+  const std::vector<uint32_t> offsets = {0, 3, 7};
+  const std::vector<uint32_t> indices = {0, 1, 2, 0, 1, 2, 3};
+  EXPECT_EQ(model.GetFaceOffsets(), offsets);
+  EXPECT_EQ(model.GetFaceIndices(), indices);
+
+  const auto polys = model.GetPolygons();
+  ASSERT_EQ(polys.size(), 2u);
+  EXPECT_EQ(polys[1].count_of_vertices(), 4);
+  std::vector<uint32_t> walked;
+  for (const auto poly : polys)
+    for (uint32_t v : poly) walked.push_back(v);
+  EXPECT_EQ(walked, indices);
+}
+
+// Большой файл с относительными индексами: многопоточный разбор
+// должен дать ровно то же, что и однопоточный
+TEST(ObjParser, ParallelMatchesSequential) {
+  std::string obj;
+  for (int i = 0; i < 120000; ++i) {
+    obj += "v " + std::to_string(i) + " " + std::to_string(i % 7) + " 0.5\n";
+    if (i % 3 == 2) obj += "f -3 -2 -1\n";
+    if (i % 5 == 4) obj += "f 1 " + std::to_string(i + 1) + " -2 99999999\n";
+  }
+  const std::string path = WriteTempObj(obj, "parallel.obj");
+
+  s21::ObjParser seq;
+  seq.SetThreadCount(1);
+  s21::ObjParser par;
+  par.SetThreadCount(4);
+
+  s21::Model a, b;
+  std::string err;
+  ASSERT_TRUE(seq.Load(path, a, &err)) << err;
+  ASSERT_TRUE(par.Load(path, b, &err)) << err;
+
+  ASSERT_EQ(a.GetNumVertices(), 120000);
+  ASSERT_EQ(a.GetNumVertices(), b.GetNumVertices());
+  ASSERT_EQ(a.GetPolygons().size(), b.GetPolygons().size());
+  EXPECT_EQ(a.GetNumEdges(), b.GetNumEdges());
+
+  for (size_t i = 0; i < a.GetVertices().size(); ++i) {
+    ASSERT_EQ(a.GetVertices()[i].x, b.GetVertices()[i].x) << i;
+    ASSERT_EQ(a.GetVertices()[i].y, b.GetVertices()[i].y) << i;
+  }
+  EXPECT_EQ(a.GetFaceOffsets(), b.GetFaceOffsets());
+  EXPECT_EQ(a.GetFaceIndices(), b.GetFaceIndices());
+}
+
+std::string MakeLargeObj(int vertices) {
+  std::string obj;
+  for (int i = 0; i < vertices; ++i) {
+    obj += "v " + std::to_string(i) + " " + std::to_string(i % 7) + " 0.5\n";
+    if (i % 3 == 2) obj += "f -3 -2 -1\n";
+  }
+  return obj;
+}
+
+// Рёбра и AABB, собранные конвейером по кускам, совпадают с полным
+// проходом по готовой модели (в т.ч. рёбра, общие для разных кусков)
+TEST(ObjParser, PipelinedEdgesMatchFullPass) {
+  std::string obj = MakeLargeObj(200000);
+  for (int i = 3; i <= 200000; i += 1000)
+    obj += "f 1 2 " + std::to_string(i) + "\nf 2 1 " + std::to_string(i) +
+           "\n";
+  const std::string path = WriteTempObj(obj, "pipeline.obj");
+
+  s21::ObjParser parser;
+  parser.SetThreadCount(4);
+  s21::Model m;
+  std::string err;
+  ASSERT_TRUE(parser.Load(path, m, &err)) << err;
+
+  auto pairs = [](const std::vector<uint32_t> &edges) {
+    std::vector<std::pair<uint32_t, uint32_t>> p;
+    for (size_t i = 0; i + 1 < edges.size(); i += 2)
+      p.emplace_back(edges[i], edges[i + 1]);
+    std::sort(p.begin(), p.end());
+    return p;
+  };
+  s21::Model full = m;
+  full.RebuildEdges(1);
+  EXPECT_EQ(m.GetNumEdges(), full.GetNumEdges());
+  EXPECT_EQ(pairs(m.GetEdges()), pairs(full.GetEdges()));
+
+  const auto box = m.ComputeAabb();
+  const auto exact = m.ComputeExactAabb();
+  EXPECT_EQ(box.min.x, exact.min.x);
+  EXPECT_EQ(box.max.x, exact.max.x);
+  EXPECT_EQ(box.max.y, exact.max.y);
+  EXPECT_EQ(box.max.z, exact.max.z);
+}
+
+// Части модели по ходу загрузки: вершины всех кусков совпадают с моделью,
+// рёбра кусков покрывают её рёбра и ссылаются только на готовые вершины
+TEST(ObjParser, DeliversChunksWhileLoading) {
+  const std::string path = WriteTempObj(MakeLargeObj(200000), "chunks.obj");
+
+  std::mutex mutex;
+  std::vector<s21::LoadedChunkPtr> parts;
+  s21::LoadControl control;
+  control.SetChunkSink([&](s21::LoadedChunkPtr chunk) {
+    std::lock_guard<std::mutex> lock(mutex);
+    parts.push_back(std::move(chunk));
+  });
+  s21::ObjParser parser;
+  parser.SetThreadCount(4);
+  parser.SetLoadControl(&control);
+
+  s21::Model m;
+  std::string err;
+  ASSERT_TRUE(parser.Load(path, m, &err)) << err;
+  ASSERT_FALSE(parts.empty());
+
+  const size_t chunks = parts.front()->chunks;
+  EXPECT_EQ(parts.size(), 2 * chunks);
+  std::vector<size_t> vertex_end(chunks, 0);
+  std::vector<float> positions(m.GetVertices().size() * 3, -1.0F);
+  for (const auto &p : parts) {
+    EXPECT_EQ(p->total_vertices, m.GetVertices().size());
+    if (p->kind != s21::LoadedChunk::Kind::kVertices) continue;
+    std::copy(p->positions.begin(), p->positions.end(),
+              positions.begin() + static_cast<std::ptrdiff_t>(
+                                      p->first_vertex * 3));
+    vertex_end[p->index] = p->first_vertex + p->positions.size() / 3;
+  }
+  for (size_t i = 0; i < m.GetVertices().size(); ++i) {
+    ASSERT_EQ(positions[3 * i], static_cast<float>(m.GetVertices()[i].x));
+    ASSERT_EQ(positions[3 * i + 1], static_cast<float>(m.GetVertices()[i].y));
+  }
+
+  std::set<std::pair<uint32_t, uint32_t>> seen;
+  for (const auto &p : parts) {
+    if (p->kind != s21::LoadedChunk::Kind::kEdges) continue;
+    for (size_t i = 0; i + 1 < p->edges.size(); i += 2) {
+      ASSERT_LT(p->edges[i + 1], vertex_end[p->index]);
+      seen.emplace(p->edges[i], p->edges[i + 1]);
+    }
+  }
+  const auto &edges = m.GetEdges();
+  EXPECT_EQ(seen.size(), edges.size() / 2);
+  for (size_t i = 0; i + 1 < edges.size(); i += 2)
+    EXPECT_TRUE(seen.count({edges[i], edges[i + 1]}));
+}
+
+TEST(ObjParser, ReportsProgressUpToFileSize) {
+  const std::string obj = MakeLargeObj(200000);
+  const std::string path = WriteTempObj(obj, "progress.obj");
+
+  std::mutex mutex;
+  std::vector<uint64_t> reports;
+  uint64_t total_seen = 0;
+  s21::LoadControl control([&](uint64_t bytes, uint64_t total) {
+    std::lock_guard<std::mutex> lock(mutex);
+    reports.push_back(bytes);
+    total_seen = total;
+  });
+  s21::ObjParser parser;
+  parser.SetThreadCount(4);
+  parser.SetLoadControl(&control);
+
+  s21::Model m;
+  std::string err;
+  ASSERT_TRUE(parser.Load(path, m, &err)) << err;
+  ASSERT_FALSE(reports.empty());
+  EXPECT_EQ(total_seen, obj.size());
+  EXPECT_EQ(reports.back(), obj.size());
+  EXPECT_LE(reports.size(), 101u);
+}
+
+TEST(ObjParser, CancelledLoadFailsAndReleasesModel) {
+  const std::string path = WriteTempObj(MakeLargeObj(200000), "cancel.obj");
+
+  // Отмена из первого же отчёта о прогрессе — как при новой загрузке
+  s21::LoadControl *self = nullptr;
+  s21::LoadControl control([&](uint64_t, uint64_t) { self->Cancel(); });
+  self = &control;
+  s21::ObjParser parser;
+  parser.SetThreadCount(2);
+  parser.SetLoadControl(&control);
+
+  s21::Model m;
+  std::string err;
+  EXPECT_FALSE(parser.Load(path, m, &err));
+  EXPECT_EQ(err, s21::IModelLoader::kCancelledError);
+  EXPECT_EQ(m.GetNumVertices(), 0);
+  EXPECT_TRUE(m.GetVertices().empty());
+
+  // Отменённый заранее — файл даже не открывается
+  s21::LoadControl cancelled;
+  cancelled.Cancel();
+  parser.SetLoadControl(&cancelled);
+  EXPECT_FALSE(parser.Load(path, m, &err));
+  EXPECT_EQ(err, s21::IModelLoader::kCancelledError);
+}
+
+// ParseDouble обязан совпадать с strtod бит в бит (в локали "C")
+void ExpectSameAsStrtod(const std::string &text) {
+  char *e = nullptr;
+  const double expected = std::strtod(text.c_str(), &e);
+  double actual = 0.0;
+  const char *end = text.data() + text.size();
+  const char *p = s21::ParseDouble(text.data(), end, actual);
+
+  EXPECT_EQ(p - text.data(), e - text.c_str()) << text;
+  if (std::isnan(expected)) {
+    EXPECT_TRUE(std::isnan(actual)) << text;
+  } else {
+    EXPECT_EQ(0, std::memcmp(&expected, &actual, sizeof(double)))
+        << text << ": " << expected << " vs " << actual;
+  }
+}
+
+TEST(FastNumber, ParseDoubleEdgeCases) {
+  const char *cases[] = {"0",
+                         "-0",
+                         "+1",
+                         "1.",
+                         ".5",
+                         "-.5e1",
+                         "1e",
+                         "1e+",
+                         "2.5E-3",
+                         "123456789012345678",
+                         "9007199254740993",
+                         "0.1",
+                         "1e22",
+                         "1e23",
+                         "4.9e-324",
+                         "2.2250738585072011e-308",
+                         "1.7976931348623157e308",
+                         "1e309",
+                         "-1e400",
+                         "1e-400",
+                         "inf",
+                         "-nan",
+                         "0x1p3",
+                         "0x",
+                         ".",
+                         "-",
+                         "abc",
+                         "00000000000000000000000001.5",
+                         "3.14159265358979323846264338",
+                         "1/2/3",
+                         "7//9",
+                         "12345678.87654321"};
+  for (const char *c : cases) ExpectSameAsStrtod(c);
+}
+
+TEST(FastNumber, ParseDoubleFuzzedCorpus) {
+  std::mt19937_64 rng(20240917);
+  auto digits = [&](int n) {
+    std::string d;
+    for (int i = 0; i < n; ++i) d += static_cast<char>('0' + rng() % 10);
+    return d;
+  };
+  for (int i = 0; i < 200000; ++i) {
+    std::string t;
+    const int sign = static_cast<int>(rng() % 3);
+    if (sign == 1) t += '-';
+    if (sign == 2) t += '+';
+    t += digits(static_cast<int>(rng() % 12));
+    if (rng() % 4 != 0) t += '.' + digits(static_cast<int>(rng() % 20));
+    if (rng() % 3 == 0) {
+      t += (rng() % 2) ? 'e' : 'E';
+      if (rng() % 2) t += (rng() % 2) ? '-' : '+';
+      t += std::to_string(rng() % 340);
+    }
+    ExpectSameAsStrtod(t);
+    if (HasFailure()) break;
+  }
+}
+
+TEST(FastNumber, ParseLongLikeStrtol) {
+  const char *cases[] = {"0", "-12/3/4", "+7", "42abc", "-", "x",
+                         "99999999999999999999999", "-99999999999999999999"};
+  for (const char *c : cases) {
+    char *e = nullptr;
+    const long expected = std::strtol(c, &e, 10);
+    long actual = 0;
+    const char *p = s21::ParseLong(c, c + std::strlen(c), actual);
+    EXPECT_EQ(expected, actual) << c;
+    EXPECT_EQ(p, e) << c;
+  }
+}
+
+TEST(ObjParser, VertexCoordinatesAreExact) {
+  const std::string path =
+      WriteTempObj("v 0.1 -2.5e-3 1234.5678\nv  1e2\t.5 -0\n", "exact.obj");
+  s21::Model model;
+  s21::ObjParser parser;
+  ASSERT_TRUE(parser.Load(path, model));
+  ASSERT_EQ(model.GetNumVertices(), 2);
+  // Точно как strtod, приведённый к типу хранения модели
+  using Scalar = s21::Model::Scalar;
+  EXPECT_EQ(model.GetVertices()[0].x, static_cast<Scalar>(0.1));
+  EXPECT_EQ(model.GetVertices()[0].y, static_cast<Scalar>(-2.5e-3));
+  EXPECT_EQ(model.GetVertices()[0].z, static_cast<Scalar>(1234.5678));
+  EXPECT_EQ(model.GetVertices()[1].x, 100.0);
+  EXPECT_EQ(model.GetVertices()[1].y, 0.5);
+  EXPECT_EQ(model.GetVertices()[1].z, 0.0);
+}
+
 }  // namespace
@@ -0,0 +1,117 @@
+// clazy:excludeall=non-pod-global-static
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "model/obj_model.h"
+#include "model/transform_state.h"
+#include "test_utils.h"
+
+namespace {
+
+constexpr double kEps = 1e-9;
+
+constexpr const char kBoxObj[] =
+    "v -1 -2 -3\n"
+    "v 3 2 5\n"
+    "v 0 1 -1\n"
+    "f 1 2 3\n";
+
+s21::Model::Aabb MakeBox(double x0, double y0, double z0, double x1,
+                         double y1, double z1) {
+  s21::Model::Aabb box;
+  box.min = s21::Model::Vertex(static_cast<s21::Model::Scalar>(x0),
+                               static_cast<s21::Model::Scalar>(y0),
+                               static_cast<s21::Model::Scalar>(z0));
+  box.max = s21::Model::Vertex(static_cast<s21::Model::Scalar>(x1),
+                               static_cast<s21::Model::Scalar>(y1),
+                               static_cast<s21::Model::Scalar>(z1));
+  return box;
+}
+
+TEST(TransformState, RotationKeepsPivot) {
+  s21::TransformState state;
+  state.Reset(MakeBox(-1, -2, -3, 3, 2, 5));
+  state.Translate(1.0, 0.0, 0.0);
+  state.Rotate(1, 37.0);
+  state.Rotate(0, -12.0);
+
+  double c[3];
+  state.Pivot(c);
+  EXPECT_NEAR(c[0], 2.0, kEps);
+  EXPECT_NEAR(c[1], 0.0, kEps);
+  EXPECT_NEAR(c[2], 1.0, kEps);
+}
+
+TEST(TransformState, MatchesModelTransforms) {
+  // Одна и та же последовательность через состояние и через модель
+  s21::Model m;
+  std::string err;
+  ASSERT_TRUE(LoadModelFromObjString(kBoxObj, m, &err, "ts.obj")) << err;
+
+  s21::TransformState state;
+  state.Reset(m.ComputeAabb());
+  state.Rotate(2, 30.0);
+  state.Scale(1.5);
+  state.Translate(0.5, -1.0, 2.0);
+  state.Rotate(1, -75.0);
+
+  m.RotateZ(30.0);
+  m.Scale(1.5);
+  m.Translate(0.5, -1.0, 2.0);
+  m.RotateY(-75.0);
+
+  const s21::Model::Affine &a = state.affine();
+  const s21::Model::Affine &b = m.GetPendingTransform();
+  for (int i = 0; i < 9; ++i) EXPECT_NEAR(a.a[i], b.a[i], kEps) << i;
+  for (int i = 0; i < 3; ++i) EXPECT_NEAR(a.t[i], b.t[i], kEps) << i;
+}
+
+TEST(TransformState, RowMajorMatrix) {
+  s21::TransformState state;
+  state.Reset(MakeBox(0, 0, 0, 0, 0, 0));
+  state.Scale(2.0);
+  state.Translate(1.0, 2.0, 3.0);
+
+  float m[16];
+  state.ToRowMajor(m);
+  const float expected[16] = {2, 0, 0, 1, 0, 2, 0, 2, 0, 0, 2, 3, 0, 0, 0, 1};
+  for (int i = 0; i < 16; ++i) EXPECT_FLOAT_EQ(m[i], expected[i]) << i;
+}
+
+TEST(TransformState, BakeLeavesModelInPlace) {
+  s21::Model m;
+  std::string err;
+  ASSERT_TRUE(LoadModelFromObjString(kBoxObj, m, &err, "ts.obj")) << err;
+
+  s21::TransformState state;
+  state.Reset(m.ComputeAabb());
+  state.Translate(4.0, 0.0, 0.0);
+  state.Rotate(2, 90.0);
+  double before[3];
+  state.Pivot(before);
+
+  const uint64_t geometry = m.GeometryVersion();
+  m.Transform(state.affine());
+  state.MarkBaked();
+  EXPECT_NE(m.GeometryVersion(), geometry);
+  EXPECT_TRUE(state.IsIdentity());
+
+  // Опорная точка после запекания та же, что и до него
+  double after[3];
+  state.Pivot(after);
+  for (int i = 0; i < 3; ++i) EXPECT_NEAR(after[i], before[i], kEps);
+
+  // Вершины получили то же преобразование, что показывал шейдер
+  const auto &vs = m.GetVertices();
+  EXPECT_NEAR(vs[0].x, 7.0, 1e-5);
+  EXPECT_NEAR(vs[0].y, -2.0, 1e-5);
+  EXPECT_NEAR(vs[0].z, -3.0, 1e-5);
+
+  // Единичное преобразование модель не трогает
+  const uint64_t baked = m.GeometryVersion();
+  m.Transform(state.affine());
+  EXPECT_EQ(m.GeometryVersion(), baked);
+}
+
+}  // namespace
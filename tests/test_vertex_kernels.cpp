@@ -0,0 +1,99 @@
+// clazy:excludeall=non-pod-global-static
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "model/obj_model.h"
+#include "model/vertex_kernels.h"
+
+namespace {
+
+// float-ядра считают в float, скалярный путь — в double
+constexpr double kTol =
+    std::is_same<s21::Model::Scalar, float>::value ? 1e-3 : 1e-9;
+
+std::vector<s21::Model::Vertex> RandomVertices(size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> d(-100.0, 100.0);
+  std::vector<s21::Model::Vertex> vs;
+  vs.reserve(n);
+  for (size_t i = 0; i < n; ++i) vs.emplace_back(d(rng), d(rng), d(rng));
+  return vs;
+}
+
+s21::Model::Affine SomeAffine() {
+  s21::Model::Affine m;
+  const double a[9] = {0.36, 0.48, -0.8, -0.8, 0.6, 0.0, 0.48, 0.64, 0.6};
+  for (int i = 0; i < 9; ++i) m.a[i] = a[i] * 1.5;
+  m.t[0] = 3.0;
+  m.t[1] = -7.25;
+  m.t[2] = 0.5;
+  return m;
+}
+
+// Уровни SIMD сверяются со скалярным эталоном на всех остатках хвоста
+class VertexKernels : public ::testing::TestWithParam<s21::SimdLevel> {
+ protected:
+  void SetUp() override {
+    if (GetParam() > s21::DetectSimdLevel())
+      GTEST_SKIP() << "SIMD level is not supported by this CPU";
+  }
+  void TearDown() override { s21::SetSimdLevel(s21::DetectSimdLevel()); }
+};
+
+TEST_P(VertexKernels, BoundsMatchScalar) {
+  const auto m = SomeAffine();
+  for (size_t n : {1u, 2u, 3u, 4u, 5u, 7u, 8u, 9u, 13u, 1000u}) {
+    const auto vs = RandomVertices(n, static_cast<unsigned>(n));
+
+    s21::SetSimdLevel(s21::SimdLevel::kScalar);
+    const auto ref = s21::ComputeBounds(vs.data(), n);
+    const auto ref_m = s21::ComputeBounds(vs.data(), n, &m);
+
+    s21::SetSimdLevel(GetParam());
+    const auto got = s21::ComputeBounds(vs.data(), n);
+    const auto got_m = s21::ComputeBounds(vs.data(), n, &m);
+
+    EXPECT_EQ(got.min.x, ref.min.x) << n;
+    EXPECT_EQ(got.min.y, ref.min.y) << n;
+    EXPECT_EQ(got.min.z, ref.min.z) << n;
+    EXPECT_EQ(got.max.x, ref.max.x) << n;
+    EXPECT_EQ(got.max.y, ref.max.y) << n;
+    EXPECT_EQ(got.max.z, ref.max.z) << n;
+
+    EXPECT_NEAR(got_m.min.x, ref_m.min.x, kTol) << n;
+    EXPECT_NEAR(got_m.min.y, ref_m.min.y, kTol) << n;
+    EXPECT_NEAR(got_m.min.z, ref_m.min.z, kTol) << n;
+    EXPECT_NEAR(got_m.max.x, ref_m.max.x, kTol) << n;
+    EXPECT_NEAR(got_m.max.y, ref_m.max.y, kTol) << n;
+    EXPECT_NEAR(got_m.max.z, ref_m.max.z, kTol) << n;
+  }
+}
+
+TEST_P(VertexKernels, TransformMatchesScalar) {
+  const auto m = SomeAffine();
+  for (size_t n : {1u, 2u, 3u, 4u, 5u, 6u, 7u, 11u, 1001u}) {
+    auto ref = RandomVertices(n, 7);
+    auto got = ref;
+    for (auto &v : ref) v = m.Apply(v);
+
+    s21::SetSimdLevel(GetParam());
+    s21::TransformVertices(got.data(), n, m);
+
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_NEAR(got[i].x, ref[i].x, kTol) << n << ':' << i;
+      EXPECT_NEAR(got[i].y, ref[i].y, kTol) << n << ':' << i;
+      EXPECT_NEAR(got[i].z, ref[i].z, kTol) << n << ':' << i;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Levels, VertexKernels,
+                         ::testing::Values(s21::SimdLevel::kScalar,
+                                           s21::SimdLevel::kSse2,
+                                           s21::SimdLevel::kAvx2));
+
+}  // namespace